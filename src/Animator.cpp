@@ -0,0 +1,144 @@
+#include <Animator.h>
+
+#include <algorithm>
+#include <iostream>
+
+Animator::Animator(Rubikscube* rubik)
+    : m_Rubik(rubik), m_Elapsed(0.0), m_Accumulator(0.0), m_LastTime(0.0)
+{
+}
+
+void Animator::Enqueue(const WallMove& move)
+{
+    m_Pending.Push(move);
+}
+
+void Animator::Update(double now)
+{
+    if (!IsBusy())
+    {
+        return;
+    }
+    if (m_Active.empty())
+    {
+        // Coming out of idle, start right away instead of catching up on the idle time
+        m_LastTime = now;
+        m_Accumulator = 0.0;
+        StartNext();
+    }
+
+    m_Accumulator += std::min(now - m_LastTime, MaxFrameTime);
+    m_LastTime = now;
+    while (m_Accumulator >= Timestep)
+    {
+        Step(Timestep);
+        m_Accumulator -= Timestep;
+    }
+
+    for (const WallMove& move : m_Active)
+    {
+        double t = move.duration > 0.0f ? std::min(1.0, (m_Elapsed + m_Accumulator) / move.duration) : 1.0;
+        m_Rubik->SetWallAngle(move, (float) (move.degrees * t));
+    }
+}
+
+bool Animator::Flush()
+{
+    for (const WallMove& move : m_Active)
+    {
+        m_Rubik->EndWallRotation(move);
+    }
+    m_Active.clear();
+    int dropped = 0;
+    while (!m_Pending.Empty())
+    {
+        if (!m_Rubik->ApplyWallMove(m_Pending.Pop()))
+        {
+            dropped++;
+        }
+    }
+    m_Accumulator = 0.0;
+    if (dropped > 0)
+    {
+        std::cout << "Dropped " << dropped << " queued moves, a half turned wall locks their axis" << std::endl;
+    }
+    return dropped == 0;
+}
+
+bool Animator::Start(const WallMove& move, double now)
+{
+    Flush();
+    if (!m_Rubik->BeginWallRotation(move))
+    {
+        return false;
+    }
+    m_Active.push_back(move);
+    m_Elapsed = 0.0;
+    m_LastTime = now;
+    return true;
+}
+
+// Starts the next group: the first queued move the cube accepts (an axis may be locked by
+// a half turned wall) and every following move on another layer of the same axis
+void Animator::StartNext()
+{
+    m_Active.clear();
+    m_Elapsed = 0.0;
+    while (!m_Pending.Empty())
+    {
+        WallMove move = m_Pending.Peek();
+        if (!m_Active.empty())
+        {
+            bool sameLayer = std::any_of(m_Active.begin(), m_Active.end(),
+                [&](const WallMove& active) { return active.layer == move.layer; });
+            if (move.axis != m_Active[0].axis || sameLayer)
+            {
+                return;
+            }
+        }
+        m_Pending.Pop();
+        if (m_Rubik->BeginWallRotation(move))
+        {
+            m_Active.push_back(move);
+        }
+    }
+}
+
+// Ends the moves of the group that are done by the given time
+void Animator::FinishMoves(double elapsed)
+{
+    for (auto it = m_Active.begin(); it != m_Active.end();)
+    {
+        if (it->duration <= elapsed)
+        {
+            m_Rubik->EndWallRotation(*it);
+            it = m_Active.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
+void Animator::Step(double dt)
+{
+    while (!m_Active.empty())
+    {
+        double remaining = 0.0;
+        for (const WallMove& move : m_Active)
+        {
+            remaining = std::max(remaining, move.duration - m_Elapsed);
+        }
+        if (dt < remaining)
+        {
+            m_Elapsed += dt;
+            FinishMoves(m_Elapsed);
+            return;
+        }
+        // The group finishes inside this step, the rest of the step goes to the next one
+        dt -= remaining;
+        FinishMoves(m_Elapsed + remaining);
+        StartNext();
+    }
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <WallMove.h>
+#include <MoveQueue.h>
+#include "RubiksCube.h"
+
+#include <vector>
+
+// Plays queued wall turns over wall-clock time. Input only enqueues moves, the main loop
+// calls Update once per frame: the simulation advances in fixed timesteps and the layer
+// angles are interpolated from the simulated time, so turn speed does not depend on the
+// refresh rate and input is never blocked by an animation.
+// Consecutive moves on different layers of the same axis commute, so they are started
+// together as one group and animated in the same frames.
+class Animator
+{
+    private:
+        Rubikscube* m_Rubik;
+        MoveQueue m_Pending;
+        std::vector<WallMove> m_Active; // The group being animated
+        double m_Elapsed;     // Simulated time since the group started
+        double m_Accumulator; // Real time not yet simulated
+        double m_LastTime;
+
+    public:
+        static constexpr double Timestep = 1.0 / 240.0;
+        // Longer frames (stalls, dragging the window) are clamped instead of skipping the animation
+        static constexpr double MaxFrameTime = 0.25;
+
+        Animator(Rubikscube* rubik);
+
+        void Enqueue(const WallMove& move);
+        void Update(double now);
+        // Ends the animating group and applies every queued move without animation, moves the
+        // cube rejects are dropped like in StartNext. Returns false when one was dropped.
+        bool Flush();
+        // Flushes, then starts animating move right away. Returns false when the cube rejects it
+        // (another axis is locked by a half turned wall).
+        bool Start(const WallMove& move, double now);
+
+        inline bool IsBusy() const { return !m_Active.empty() || !m_Pending.Empty(); }
+
+    private:
+        void StartNext();
+        void Step(double dt);
+        void FinishMoves(double elapsed);
+};
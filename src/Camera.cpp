@@ -17,6 +17,9 @@ void Camera::SetOrthographic(float near, float far)
 // Input Callbacks //
 /////////////////////
 
+// Scramble turns run at the former 45 degrees per frame at 60 Hz
+const float scrambleDegreesPerSecond = 2700.0f;
+
 void KeyCallback(GLFWwindow* window, int key, int scanCode, int action, int mods)
 {
     Camera* camera = (Camera*) glfwGetWindowUserPointer(window);
@@ -32,67 +35,49 @@ void KeyCallback(GLFWwindow* window, int key, int scanCode, int action, int mods
             case GLFW_KEY_R:
                 std::cout << "R Pressed" << std::endl;
                 // Rotate the Rubik's Cube right wall
-                if (camera->rubik) {
+                if (camera->rubik && camera->animator) {
                     glm::vec3 rotationAxis = glm::vec3(1.0f, 0.0f, 0.0f);
-                    glm::mat4 mvp = camera->GetProjectionMatrix() * camera->GetViewMatrix();
-                    for(int i=1; i<=camera->GetRotationFactor();i++){
-                        camera->rubik->RotateWall45(1, rotationAxis, mvp, window, 1.0f);
-                    }
+                    camera->animator->Enqueue(camera->rubik->MakeWallMove(1, rotationAxis, camera->GetRotationFactor()));
                 }
                 break;
             case GLFW_KEY_L:
                 std::cout << "L Pressed" << std::endl;
                 // Rotate the Rubik's Cube left wall
-                if (camera->rubik) {
+                if (camera->rubik && camera->animator) {
                     glm::vec3 rotationAxis = glm::vec3(1.0f, 0.0f, 0.0f);
-                    glm::mat4 mvp = camera->GetProjectionMatrix() * camera->GetViewMatrix();
-                    for(int i=1; i<=camera->GetRotationFactor();i++){
-                        camera->rubik->RotateWall45(-1, rotationAxis, mvp, window, 1.0f);
-                    }
+                    camera->animator->Enqueue(camera->rubik->MakeWallMove(-1, rotationAxis, camera->GetRotationFactor()));
                 }
                 break;
             case GLFW_KEY_U:
                 std::cout << "U Pressed" << std::endl;
                 // Rotate the Rubik's Cube up wall
-                if (camera->rubik) {
+                if (camera->rubik && camera->animator) {
                     glm::vec3 rotationAxis = glm::vec3(0.0f, 1.0f, 0.0f);
-                    glm::mat4 mvp = camera->GetProjectionMatrix() * camera->GetViewMatrix();
-                    for(int i=1; i<=camera->GetRotationFactor();i++){
-                        camera->rubik->RotateWall45(1, rotationAxis, mvp, window, 1.0f);
-                    }
+                    camera->animator->Enqueue(camera->rubik->MakeWallMove(1, rotationAxis, camera->GetRotationFactor()));
                 }
                 break;
             case GLFW_KEY_D:
                 std::cout << "D Pressed" << std::endl;
                 // Rotate the Rubik's Cube down wall
-                if (camera->rubik) {
+                if (camera->rubik && camera->animator) {
                     glm::vec3 rotationAxis = glm::vec3(0.0f, 1.0f, 0.0f);
-                    glm::mat4 mvp = camera->GetProjectionMatrix() * camera->GetViewMatrix();
-                    for(int i=1; i<=camera->GetRotationFactor();i++){
-                        camera->rubik->RotateWall45(-1, rotationAxis, mvp, window, 1.0f);
-                    }
+                    camera->animator->Enqueue(camera->rubik->MakeWallMove(-1, rotationAxis, camera->GetRotationFactor()));
                 }
                 break;
             case GLFW_KEY_B:
                 std::cout << "B Pressed" << std::endl;
                 // Rotate the Rubik's Cube back wall
-                if (camera->rubik) {
+                if (camera->rubik && camera->animator) {
                     glm::vec3 rotationAxis = glm::vec3(0.0f, 0.0f, 1.0f);
-                    glm::mat4 mvp = camera->GetProjectionMatrix() * camera->GetViewMatrix();
-                    for(int i=1; i<=camera->GetRotationFactor();i++){
-                        camera->rubik->RotateWall45(-1, rotationAxis, mvp, window, 1.0f);
-                    }
+                    camera->animator->Enqueue(camera->rubik->MakeWallMove(-1, rotationAxis, camera->GetRotationFactor()));
                 }
                 break;
             case GLFW_KEY_F:
                 std::cout << "F Pressed" << std::endl;
                 // Rotate the Rubik's Cube front wall
-                if (camera->rubik) {
+                if (camera->rubik && camera->animator) {
                     glm::vec3 rotationAxis = glm::vec3(0.0f, 0.0f, 1.0f);
-                    glm::mat4 mvp = camera->GetProjectionMatrix() * camera->GetViewMatrix();
-                    for(int i=1; i<=camera->GetRotationFactor();i++){
-                        camera->rubik->RotateWall45(1, rotationAxis, mvp, window, 1.0f);
-                    }
+                    camera->animator->Enqueue(camera->rubik->MakeWallMove(1, rotationAxis, camera->GetRotationFactor()));
                 }
                 break;
             case GLFW_KEY_SPACE:
@@ -167,7 +152,7 @@ void KeyCallback(GLFWwindow* window, int key, int scanCode, int action, int mods
             case GLFW_KEY_M:
                 std::cout << "M Pressed" << std::endl;
                 // Mixing the Rubiks cube
-                if (camera->rubik) {
+                if (camera->rubik && camera->animator) {
                     if(camera->rubik->getSize()==3){
                         std::random_device rd;  // Random device (seed generator)
                         std::mt19937 gen(rd()); // Mersenne Twister random number generator
@@ -176,47 +161,34 @@ void KeyCallback(GLFWwindow* window, int key, int scanCode, int action, int mods
                         std::uniform_int_distribution<> dist(1, 6);
                         int randomNumber;
                         glm::vec3 rotationAxis;
-                        glm::mat4 mvp;
                         for(int i=0; i<100; i++){
                             randomNumber = dist(gen);
                             switch (randomNumber)
                             {
-                                // Getting a random wall to rotate and rotating it by 90 degrees with the sensitivity of 45 degrees so it happens fast
+                                // Getting a random wall to rotate and rotating it by 90 degrees fast
                                 case 1:
                                     rotationAxis = glm::vec3(1.0f, 0.0f, 0.0f);
-                                    mvp = camera->GetProjectionMatrix() * camera->GetViewMatrix();
-                                    camera->rubik->RotateWall45(1, rotationAxis, mvp, window, 45.0f);
-                                    camera->rubik->RotateWall45(1, rotationAxis, mvp, window, 45.0f);
+                                    camera->animator->Enqueue(camera->rubik->MakeWallMove(1, rotationAxis, 2, scrambleDegreesPerSecond));
                                     break;
                                 case 2:
                                     rotationAxis = glm::vec3(1.0f, 0.0f, 0.0f);
-                                    mvp = camera->GetProjectionMatrix() * camera->GetViewMatrix();
-                                    camera->rubik->RotateWall45(-1, rotationAxis, mvp, window, 45.0f);
-                                    camera->rubik->RotateWall45(-1, rotationAxis, mvp, window, 45.0f);
+                                    camera->animator->Enqueue(camera->rubik->MakeWallMove(-1, rotationAxis, 2, scrambleDegreesPerSecond));
                                     break;
                                 case 3:
                                     rotationAxis = glm::vec3(0.0f, 1.0f, 0.0f);
-                                    mvp = camera->GetProjectionMatrix() * camera->GetViewMatrix();
-                                    camera->rubik->RotateWall45(1, rotationAxis, mvp, window, 45.0f);
-                                    camera->rubik->RotateWall45(1, rotationAxis, mvp, window, 45.0f);
+                                    camera->animator->Enqueue(camera->rubik->MakeWallMove(1, rotationAxis, 2, scrambleDegreesPerSecond));
                                     break;
                                 case 4:
                                     rotationAxis = glm::vec3(0.0f, 1.0f, 0.0f);
-                                    mvp = camera->GetProjectionMatrix() * camera->GetViewMatrix();
-                                    camera->rubik->RotateWall45(-1, rotationAxis, mvp, window, 45.0f);
-                                    camera->rubik->RotateWall45(-1, rotationAxis, mvp, window, 45.0f);
+                                    camera->animator->Enqueue(camera->rubik->MakeWallMove(-1, rotationAxis, 2, scrambleDegreesPerSecond));
                                     break;
                                 case 5:
                                     rotationAxis = glm::vec3(0.0f, 0.0f, 1.0f);
-                                    mvp = camera->GetProjectionMatrix() * camera->GetViewMatrix();
-                                    camera->rubik->RotateWall45(1, rotationAxis, mvp, window, 45.0f);
-                                    camera->rubik->RotateWall45(1, rotationAxis, mvp, window, 45.0f);
+                                    camera->animator->Enqueue(camera->rubik->MakeWallMove(1, rotationAxis, 2, scrambleDegreesPerSecond));
                                     break;
                                 case 6:
                                     rotationAxis = glm::vec3(0.0f, 0.0f, 1.0f);
-                                    mvp = camera->GetProjectionMatrix() * camera->GetViewMatrix();
-                                    camera->rubik->RotateWall45(-1, rotationAxis, mvp, window, 45.0f);
-                                    camera->rubik->RotateWall45(-1, rotationAxis, mvp, window, 45.0f);
+                                    camera->animator->Enqueue(camera->rubik->MakeWallMove(-1, rotationAxis, 2, scrambleDegreesPerSecond));
                                     break;
 
                                 default:
@@ -228,24 +200,139 @@ void KeyCallback(GLFWwindow* window, int key, int scanCode, int action, int mods
                     }
                 }
                 break;
+            case GLFW_KEY_P:
+                std::cout << "P Pressed" << std::endl;
+                // Play or pause the loaded move sequence
+                if (camera->playback) {
+                    if (camera->playback->IsPlaying()) {
+                        camera->playback->Pause();
+                    } else {
+                        camera->playback->Play();
+                    }
+                }
+                break;
+            case GLFW_KEY_HOME:
+            case GLFW_KEY_END:
+            case GLFW_KEY_COMMA:
+            case GLFW_KEY_PERIOD:
+                // Seek to the start, the end or one move back / forward
+                if (camera->playback) {
+                    camera->playback->Pause();
+                    int position = camera->playback->GetPosition();
+                    if (key == GLFW_KEY_HOME) position = 0;
+                    if (key == GLFW_KEY_END) position = camera->playback->GetLength();
+                    if (key == GLFW_KEY_COMMA) position--;
+                    if (key == GLFW_KEY_PERIOD) position++;
+                    camera->playback->Seek(position);
+                    std::cout << "Move " << camera->playback->GetPosition() << "/" << camera->playback->GetLength() << std::endl;
+                }
+                break;
+            case GLFW_KEY_EQUAL:
+            case GLFW_KEY_MINUS:
+                // Double or halve the playback rate
+                if (camera->playback) {
+                    camera->playback->SetRate(camera->playback->GetRate() * (key == GLFW_KEY_EQUAL ? 2.0 : 0.5));
+                    std::cout << "Playback at " << camera->playback->GetRate() << " moves per second" << std::endl;
+                }
+                break;
             default:
                 break;
         }
     }
 }
 
-void MouseButtonCallback(GLFWwindow* window, double currMouseX, double currMouseY)
+// Cursor movement in pixels before a drag on a sticker picks its turn
+const double turnDragThreshold = 8.0;
+
+void MouseButtonCallback(GLFWwindow* window, int button, int action, int mods)
 {
-    if (glfwGetMouseButton(window, GLFW_MOUSE_BUTTON_LEFT) == GLFW_PRESS)
+    Camera* camera = (Camera*) glfwGetWindowUserPointer(window);
+    if (!camera) {
+        std::cout << "Warning: Camera wasn't set as the Window User Pointer! MouseButtonCallback is skipped" << std::endl;
+        return;
+    }
+    if (button == GLFW_MOUSE_BUTTON_LEFT && action == GLFW_RELEASE)
+    {
+        camera->m_TurnDrag = false;
+        camera->m_PickPending = false;
+        return;
+    }
+    if (action != GLFW_PRESS)
+    {
+        return;
+    }
+
+    if (button == GLFW_MOUSE_BUTTON_LEFT)
     {
         std::cout << "MOUSE LEFT Click" << std::endl;
+        // Pressing on a sticker starts a turn drag, anywhere else the cube is rotated as before
+        double x, y;
+        glfwGetCursorPos(window, &x, &y);
+        camera->m_DragStartX = x;
+        camera->m_DragStartY = y;
+        if (camera->idPicker && camera->rubik && camera->animator)
+        {
+            // The ID buffer is in framebuffer pixels, the answer arrives in HandleGpuPick
+            int windowWidth, windowHeight, framebufferWidth, framebufferHeight;
+            glfwGetWindowSize(window, &windowWidth, &windowHeight);
+            glfwGetFramebufferSize(window, &framebufferWidth, &framebufferHeight);
+            camera->idPicker->Request((int) (x * framebufferWidth / std::max(windowWidth, 1)),
+                                      (int) (y * framebufferHeight / std::max(windowHeight, 1)));
+            camera->m_TurnDrag = false;
+            camera->m_PickPending = true;
+            return;
+        }
+        camera->m_TurnDrag = camera->rubik && camera->animator &&
+            camera->rubik->Pick(camera->GetRay(x, y), camera->m_DragHit) && camera->m_DragHit.face >= 0;
     }
-    else if (glfwGetMouseButton(window, GLFW_MOUSE_BUTTON_RIGHT) == GLFW_PRESS)
+    else if (button == GLFW_MOUSE_BUTTON_RIGHT)
     {
         std::cout << "MOUSE RIGHT Click" << std::endl;
     }
 }
 
+// Turns the layer under the dragged sticker in the direction of the drag
+static void TurnDrag(Camera* camera, double currMouseX, double currMouseY)
+{
+    double dx = currMouseX - camera->m_DragStartX;
+    double dy = currMouseY - camera->m_DragStartY;
+    if (dx * dx + dy * dy < turnDragThreshold * turnDragThreshold)
+    {
+        return;
+    }
+    camera->m_TurnDrag = false;
+    const PickResult& hit = camera->m_DragHit;
+
+    // Where the cursor is now on the plane of the picked face, in grid space
+    Ray ray = camera->rubik->ToGridSpace(camera->GetRay(currMouseX, currMouseY));
+    int normal = hit.normalAxis;
+    if (ray.direction[normal] == 0.0f)
+    {
+        return;
+    }
+    float t = (hit.point[normal] - ray.origin[normal]) / ray.direction[normal];
+    glm::vec3 drag = ray.origin + t * ray.direction - hit.point;
+
+    // The drag follows one of the two axes in the face, the layer turns around the third
+    int along = (normal + 1) % 3;
+    int other = (normal + 2) % 3;
+    if (std::abs(drag[other]) > std::abs(drag[along]))
+    {
+        std::swap(along, other);
+    }
+    int axis = other;
+
+    // A positive turn around axis moves the face's points along axis x normal
+    glm::vec3 axisVector(0.0f), normalVector(0.0f);
+    axisVector[axis] = 1.0f;
+    normalVector[normal] = (float) hit.normalSign;
+    float motion = glm::cross(axisVector, normalVector)[along];
+    float sign = (motion * drag[along] > 0.0f) ? 1.0f : -1.0f;
+
+    float degrees = 45.0f * camera->GetRotationFactor() * sign;
+    camera->animator->Enqueue({ axis, hit.cubie[axis], degrees, std::abs(degrees) / wallDegreesPerSecond });
+}
+
 void CursorPosCallback(GLFWwindow* window, double currMouseX, double currMouseY)
 {
     Camera* camera = (Camera*) glfwGetWindowUserPointer(window);
@@ -259,7 +346,16 @@ void CursorPosCallback(GLFWwindow* window, double currMouseX, double currMouseY)
     camera->m_OldMouseX = currMouseX;
     camera->m_OldMouseY = currMouseY;
 
-    if (glfwGetMouseButton(window, GLFW_MOUSE_BUTTON_LEFT) == GLFW_PRESS)
+    if (camera->m_PickPending)
+    {
+        // Neither turn nor rotate until the GPU says what was pressed
+        return;
+    }
+    if (camera->m_TurnDrag)
+    {
+        TurnDrag(camera, currMouseX, currMouseY);
+    }
+    else if (glfwGetMouseButton(window, GLFW_MOUSE_BUTTON_LEFT) == GLFW_PRESS)
     {
         // Rotate Rubiks cube based on mouse movement
         camera->rubik->Rotate((float)camera->m_NewMouseX * 0.1f, (float)camera->m_NewMouseY * 0.1f);
@@ -290,16 +386,69 @@ void ScrollCallback(GLFWwindow* window, double scrollOffsetX, double scrollOffse
     std::cout << "SCROLL Motion" << std::endl;
 }
 
+void WindowRefreshCallback(GLFWwindow* window)
+{
+    Camera* camera = (Camera*) glfwGetWindowUserPointer(window);
+    if (camera && camera->rubik) {
+        // The window contents were damaged (exposed, resized, restored)
+        camera->rubik->MarkDirty();
+    }
+}
+
 void Camera::SetPerspective(float fov, float aspectRatio, float near, float far)
 {
     m_Projection = glm::perspective(glm::radians(fov), aspectRatio, near, far);
     m_View = glm::lookAt(m_Position, m_Position + m_Orientation, m_Up);
+    if (rubik) {
+        rubik->MarkDirty();
+    }
+}
+
+Ray Camera::GetRay(double x, double y) const
+{
+    // Window y grows downwards, GL window coordinates grow upwards
+    glm::vec4 viewport(0.0f, 0.0f, (float) m_Width, (float) m_Height);
+    glm::vec3 windowPoint((float) x, (float) (m_Height - y), 0.0f);
+    glm::vec3 nearPoint = glm::unProject(windowPoint, m_View, m_Projection, viewport);
+    windowPoint.z = 1.0f;
+    glm::vec3 farPoint = glm::unProject(windowPoint, m_View, m_Projection, viewport);
+    return { nearPoint, farPoint - nearPoint };
+}
+
+void Camera::HandleGpuPick(bool hit, const PickResult& result)
+{
+    if (!m_PickPending)
+    {
+        // The button was released before the result came back
+        return;
+    }
+    m_PickPending = false;
+    if (!hit || !rubik)
+    {
+        return;
+    }
+
+    // The ID only names the face, the drag starts where the press ray meets its plane
+    m_DragHit = result;
+    Ray ray = rubik->ToGridSpace(GetRay(m_DragStartX, m_DragStartY));
+    int normal = result.normalAxis;
+    float plane = (float) (result.cubie[normal] + (result.normalSign > 0 ? 1 : 0));
+    if (ray.direction[normal] != 0.0f)
+    {
+        float t = (plane - ray.origin[normal]) / ray.direction[normal];
+        m_DragHit.point = ray.origin + t * ray.direction;
+        m_DragHit.distance = t;
+    }
+    m_TurnDrag = true;
 }
 
 void Camera::SetPosition(const glm::vec3& position)
 {
     m_Position = position;
     m_View = glm::lookAt(m_Position, m_Position + m_Orientation, m_Up); // Update the view matrix
+    if (rubik) {
+        rubik->MarkDirty();
+    }
 }
 
 
@@ -313,23 +462,37 @@ void Camera::EnableInputs(GLFWwindow* window)
     glfwSetKeyCallback(window, (void(*)(GLFWwindow *, int, int, int, int)) KeyCallback);
 
     // Handle cursor buttons
-    glfwSetMouseButtonCallback(window, (void(*)(GLFWwindow *, int, int, int)) MouseButtonCallback);
+    glfwSetMouseButtonCallback(window, MouseButtonCallback);
 
     // Handle cursor position and inputs on motion
     glfwSetCursorPosCallback(window , (void(*)(GLFWwindow *, double, double)) CursorPosCallback);
 
     // Handle scroll inputs
     glfwSetScrollCallback(window, (void(*)(GLFWwindow *, double, double)) ScrollCallback);
+
+    // Redraw when the window needs it
+    glfwSetWindowRefreshCallback(window, (void(*)(GLFWwindow *)) WindowRefreshCallback);
 }
 
 void Camera::SetViewMatrix(glm::mat4 new_view){
     m_View = new_view;
+    if (rubik) {
+        rubik->MarkDirty();
+    }
 }
 
 void Camera::SetRubiksCube(Rubikscube* rubiksCube) {
     rubik = rubiksCube;
 }
 
+void Camera::SetAnimator(Animator* wallAnimator) {
+    animator = wallAnimator;
+}
+
+void Camera::SetPlayback(Playback* movePlayback) {
+    playback = movePlayback;
+}
+
 void Camera::SetRotationFactor(int factor){
     rotFactor=factor;
 }
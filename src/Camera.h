@@ -13,6 +13,9 @@
 #include <Debugger.h>
 #include <Shader.h>
 #include "RubiksCube.h"
+#include <Animator.h>
+#include <Playback.h>
+#include <IdPicker.h>
 #include <random> // For random number generation
 
 
@@ -47,7 +50,17 @@ class Camera
         double m_OldMouseY = 0.0;
         double m_NewMouseX = 0.0;
         double m_NewMouseY = 0.0;
+        // Drag-to-turn: set while the left button drags a sticker, see CursorPosCallback
+        bool m_TurnDrag = false;
+        PickResult m_DragHit;
+        double m_DragStartX = 0.0;
+        double m_DragStartY = 0.0;
+        // Set between a press and its GPU pick result, see HandleGpuPick
+        bool m_PickPending = false;
         Rubikscube* rubik = nullptr;
+        Animator* animator = nullptr;
+        Playback* playback = nullptr;
+        IdPicker* idPicker = nullptr;   // Optional, picks on the GPU instead of ray casting
     public:
         Camera(int width, int height);
 
@@ -63,8 +76,14 @@ class Camera
         inline glm::mat4 GetViewMatrix() const { return m_View; }
         inline glm::mat4 GetProjectionMatrix() const { return m_Projection; }
         inline glm::vec3 GetPosition() const { return m_Position; }
+        // World space ray through a cursor position in window coordinates
+        Ray GetRay(double x, double y) const;
+        // Result of the pick requested by the last left press, starts the turn drag on a hit
+        void HandleGpuPick(bool hit, const PickResult& result);
         void SetViewMatrix(glm::mat4 m_View);
         void SetRubiksCube(Rubikscube* rubiksCube);
+        void SetAnimator(Animator* wallAnimator);
+        void SetPlayback(Playback* movePlayback);
         void SetRotationFactor(int factor);
         int GetRotationFactor();
 };
\ No newline at end of file
@@ -0,0 +1,137 @@
+#include <CubeRotations.h>
+
+namespace
+{
+    // Row major whole number matrix
+    struct IntMatrix
+    {
+        int m[3][3];
+
+        bool operator==(const IntMatrix& other) const
+        {
+            for (int row = 0; row < 3; row++)
+            {
+                for (int column = 0; column < 3; column++)
+                {
+                    if (m[row][column] != other.m[row][column])
+                    {
+                        return false;
+                    }
+                }
+            }
+            return true;
+        }
+    };
+
+    IntMatrix Multiply(const IntMatrix& a, const IntMatrix& b)
+    {
+        IntMatrix result = {};
+        for (int row = 0; row < 3; row++)
+        {
+            for (int column = 0; column < 3; column++)
+            {
+                for (int k = 0; k < 3; k++)
+                {
+                    result.m[row][column] += a.m[row][k] * b.m[k][column];
+                }
+            }
+        }
+        return result;
+    }
+
+    IntMatrix QuarterTurnMatrix(int axis, int quarterTurns)
+    {
+        static const int cosines[4] = { 1, 0, -1, 0 };
+        static const int sines[4] = { 0, 1, 0, -1 };
+        int turns = ((quarterTurns % 4) + 4) % 4;
+        int c = cosines[turns], s = sines[turns];
+        int a = (axis + 1) % 3, b = (axis + 2) % 3;
+        IntMatrix result = {};
+        result.m[axis][axis] = 1;
+        result.m[a][a] = c;
+        result.m[a][b] = -s;
+        result.m[b][a] = s;
+        result.m[b][b] = c;
+        return result;
+    }
+
+    struct Tables
+    {
+        IntMatrix rotations[CubeRotations::Count];
+        glm::mat3 matrices[CubeRotations::Count];
+        unsigned char compose[CubeRotations::Count][CubeRotations::Count];
+        unsigned char quarterTurns[3][4];
+
+        int Find(const IntMatrix& rotation, int count = CubeRotations::Count) const
+        {
+            for (int i = 0; i < count; i++)
+            {
+                if (rotations[i] == rotation)
+                {
+                    return i;
+                }
+            }
+            return -1;
+        }
+
+        Tables()
+        {
+            // Every rotation is a product of quarter turns about x and y, collected breadth first
+            int count = 1;
+            rotations[0] = QuarterTurnMatrix(0, 0);
+            for (int next = 0; next < count; next++)
+            {
+                for (int axis = 0; axis < 2; axis++)
+                {
+                    IntMatrix rotation = Multiply(QuarterTurnMatrix(axis, 1), rotations[next]);
+                    if (Find(rotation, count) < 0)
+                    {
+                        rotations[count++] = rotation;
+                    }
+                }
+            }
+            for (int i = 0; i < CubeRotations::Count; i++)
+            {
+                for (int row = 0; row < 3; row++)
+                {
+                    for (int column = 0; column < 3; column++)
+                    {
+                        matrices[i][column][row] = (float) rotations[i].m[row][column];
+                    }
+                }
+                for (int j = 0; j < CubeRotations::Count; j++)
+                {
+                    compose[i][j] = (unsigned char) Find(Multiply(rotations[i], rotations[j]));
+                }
+            }
+            for (int axis = 0; axis < 3; axis++)
+            {
+                for (int turns = 0; turns < 4; turns++)
+                {
+                    quarterTurns[axis][turns] = (unsigned char) Find(QuarterTurnMatrix(axis, turns));
+                }
+            }
+        }
+    };
+
+    const Tables& GetTables()
+    {
+        static const Tables tables;
+        return tables;
+    }
+}
+
+int CubeRotations::Compose(int a, int b)
+{
+    return GetTables().compose[a][b];
+}
+
+int CubeRotations::QuarterTurn(int axis, int quarterTurns)
+{
+    return GetTables().quarterTurns[axis][((quarterTurns % 4) + 4) % 4];
+}
+
+const glm::mat3& CubeRotations::GetMatrix(int rotation)
+{
+    return GetTables().matrices[rotation];
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+// The 24 rotations that map a cube onto itself, by index. Index 0 is the identity. The
+// tables are built once from whole number matrices, so composing rotations is a lookup
+// and never rounds.
+class CubeRotations
+{
+    public:
+        static const int Count = 24;
+
+        // The rotation a after b
+        static int Compose(int a, int b);
+        // quarterTurns times 90 degrees about axis (0 x, 1 y, 2 z), right hand rule, any sign
+        static int QuarterTurn(int axis, int quarterTurns);
+        // Entries are 0, 1 or -1
+        static const glm::mat3& GetMatrix(int rotation);
+};
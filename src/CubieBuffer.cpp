@@ -0,0 +1,107 @@
+#include <CubieBuffer.h>
+
+#include <algorithm>
+
+// cube.shader reads a cubie as 9 RG32UI texels, the model matrix columns and then the face colors
+static_assert(sizeof(CubieInstance) == 9 * 2 * sizeof(unsigned int), "CubieInstance layout does not match cube.shader");
+
+CubieBuffer::CubieBuffer()
+    : m_Buffer(0u), m_TextureID(0)
+{
+    GLCall(glGenTextures(1, &m_TextureID));
+}
+
+CubieBuffer::~CubieBuffer()
+{
+    GLCall(glDeleteTextures(1, &m_TextureID));
+}
+
+void CubieBuffer::Apply(SceneSnapshot& scene)
+{
+    if (scene.cubieCount != GetCount())
+    {
+        Resize(scene.cubieCount);
+    }
+    for (size_t i = 0; i < scene.changedCubies.size(); i++)
+    {
+        const int cubie = scene.changedCubies[i];
+        m_Cubies[cubie] = scene.changedInstances[i];
+        MarkDirty(cubie);
+    }
+    scene.changedCubies.clear();
+    scene.changedInstances.clear();
+
+    // Walls past the shader's turn ranges are turned here, and put back once they are not
+    for (int cubie : m_Turned)
+    {
+        MarkDirty(cubie);
+    }
+    m_Turned.clear();
+    if (!scene.turns.overflow.empty())
+    {
+        float radians;
+        for (int cubie = 0; cubie < (int) m_Cubies.size(); cubie++)
+        {
+            if (scene.turns.GetOverflowTurn(m_Cubies[cubie].model, radians))
+            {
+                m_Turned.push_back(cubie);
+                MarkDirty(cubie);
+            }
+        }
+    }
+    Upload(scene.turns);
+}
+
+void CubieBuffer::Resize(unsigned int count)
+{
+    m_Cubies.resize(count);
+    m_IsDirty.assign(count, 0);
+    m_Dirty.clear();
+    m_Turned.clear();
+    m_Buffer.SetData(m_Cubies.data(), count * sizeof(CubieInstance));
+
+    // The texture has to be attached again whenever the store may have been reallocated
+    GLCall(glBindTexture(GL_TEXTURE_BUFFER, m_TextureID));
+    GLCall(glTexBuffer(GL_TEXTURE_BUFFER, GL_RG32UI, m_Buffer.GetRendererID()));
+    GLCall(glBindTexture(GL_TEXTURE_BUFFER, 0));
+}
+
+void CubieBuffer::MarkDirty(int cubie)
+{
+    if (!m_IsDirty[cubie])
+    {
+        m_IsDirty[cubie] = 1;
+        m_Dirty.push_back(cubie);
+    }
+}
+
+// One glBufferSubData per run of consecutive dirty cubies
+void CubieBuffer::Upload(const LayerTurns& turns)
+{
+    std::sort(m_Dirty.begin(), m_Dirty.end());
+    size_t first = 0;
+    while (first < m_Dirty.size())
+    {
+        size_t last = first;
+        while (last + 1 < m_Dirty.size() && m_Dirty[last + 1] == m_Dirty[last] + 1)
+        {
+            last++;
+        }
+        m_Staging.clear();
+        for (size_t i = first; i <= last; i++)
+        {
+            const int cubie = m_Dirty[i];
+            CubieInstance instance = m_Cubies[cubie];
+            float radians;
+            if (!turns.overflow.empty() && turns.GetOverflowTurn(instance.model, radians))
+            {
+                instance.model = LayerTurns::Rotate(instance.model, turns.axis, radians);
+            }
+            m_Staging.push_back(instance);
+            m_IsDirty[cubie] = 0;
+        }
+        m_Buffer.SubData(m_Dirty[first] * sizeof(CubieInstance), m_Staging.data(), (unsigned int) (m_Staging.size() * sizeof(CubieInstance)));
+        first = last + 1;
+    }
+    m_Dirty.clear();
+}
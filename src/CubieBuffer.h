@@ -0,0 +1,40 @@
+#pragma once
+
+#include <Debugger.h>
+#include <SceneBuffer.h>
+#include <VertexBuffer.h>
+
+#include <vector>
+
+// Render side copy of every cubie's CubieInstance, kept in one GPU buffer across frames.
+// Snapshots only carry the cubies that changed and Apply writes just those with
+// glBufferSubData, so a frame that only turns walls uploads nothing. The buffer is read as
+// instance attributes (MeshBatch) or through a texture buffer (ProceduralCubeRenderer).
+// Only used by the thread that draws.
+class CubieBuffer
+{
+    private:
+        VertexBuffer m_Buffer;
+        unsigned int m_TextureID;               // RG32UI view of m_Buffer
+        std::vector<CubieInstance> m_Cubies;    // What the cubies rest at, in cubie order
+        std::vector<int> m_Dirty;               // Cubies whose GPU copy is out of date
+        std::vector<unsigned char> m_IsDirty;
+        std::vector<int> m_Turned;              // Cubies the CPU turned for the last frame
+        std::vector<CubieInstance> m_Staging;
+
+        void Resize(unsigned int count);
+        void MarkDirty(int cubie);
+        void Upload(const LayerTurns& turns);
+
+    public:
+        CubieBuffer();
+        ~CubieBuffer();
+
+        // Takes the changed cubies out of the snapshot and brings the GPU copy up to date
+        void Apply(SceneSnapshot& scene);
+
+        inline unsigned int GetCount() const { return (unsigned int) m_Cubies.size(); }
+        inline const std::vector<CubieInstance>& GetCubies() const { return m_Cubies; }
+        inline const VertexBuffer& GetBuffer() const { return m_Buffer; }
+        inline unsigned int GetTextureID() const { return m_TextureID; }
+};
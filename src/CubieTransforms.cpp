@@ -0,0 +1,52 @@
+#include <CubieTransforms.h>
+
+#include <CubeRotations.h>
+
+int CubieTransforms::Add(int orientation, const glm::vec3& position)
+{
+    m_Orientations.push_back((unsigned char) orientation);
+    m_PX.push_back(position.x);
+    m_PY.push_back(position.y);
+    m_PZ.push_back(position.z);
+    m_IsMoved.push_back(0);
+    int cubie = GetCount() - 1;
+    MarkMoved(cubie);
+    return cubie;
+}
+
+void CubieTransforms::MarkMoved(int cubie)
+{
+    if (!m_IsMoved[cubie])
+    {
+        m_IsMoved[cubie] = 1;
+        m_Moved.push_back(cubie);
+    }
+}
+
+void CubieTransforms::QuarterTurn(int cubie, int axis, int quarterTurns)
+{
+    int turn = CubeRotations::QuarterTurn(axis, quarterTurns);
+    m_Orientations[cubie] = (unsigned char) CubeRotations::Compose(turn, m_Orientations[cubie]);
+    // Whole number matrix entries, the position stays exact
+    glm::vec3 position = CubeRotations::GetMatrix(turn) * GetPosition(cubie);
+    m_PX[cubie] = position.x;
+    m_PY[cubie] = position.y;
+    m_PZ[cubie] = position.z;
+    MarkMoved(cubie);
+}
+
+void CubieTransforms::UpdateInstances(std::vector<CubieInstance>& instances, std::vector<int>& changed)
+{
+    const int* moved = m_Moved.data();
+    const int count = (int) m_Moved.size();
+    for (int i = 0; i < count; i++)
+    {
+        const int cubie = moved[i];
+        glm::mat4& model = instances[cubie].model;
+        model = glm::mat4(CubeRotations::GetMatrix(m_Orientations[cubie]));
+        model[3] = glm::vec4(m_PX[cubie], m_PY[cubie], m_PZ[cubie], 1.0f);
+        m_IsMoved[cubie] = 0;
+    }
+    changed.insert(changed.end(), m_Moved.begin(), m_Moved.end());
+    m_Moved.clear();
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <SceneBuffer.h>
+
+#include <glm/glm.hpp>
+
+#include <vector>
+
+// Rest transforms of all cubies as structure of arrays, one of the 24 cube rotations
+// (CubeRotations) and a grid position each. Quarter turns are table lookups and exact so
+// nothing drifts. Walls that are turning or rest half turned are not stored here, the vertex
+// shader turns them (LayerTurns). Cubies that changed are remembered and only their instance
+// matrices are generated again, a table lookup and a position each.
+class CubieTransforms
+{
+    private:
+        std::vector<unsigned char> m_Orientations;    // CubeRotations index
+        std::vector<float> m_PX, m_PY, m_PZ;         // Positions
+        std::vector<int> m_Moved;
+        std::vector<unsigned char> m_IsMoved;
+
+        void MarkMoved(int cubie);
+
+    public:
+        // Returns the index of the new cubie
+        int Add(int orientation, const glm::vec3& position);
+        inline int GetCount() const { return (int) m_Orientations.size(); }
+
+        inline int GetOrientation(int cubie) const { return m_Orientations[cubie]; }
+        inline glm::vec3 GetPosition(int cubie) const { return glm::vec3(m_PX[cubie], m_PY[cubie], m_PZ[cubie]); }
+
+        // Turns the rest transform about an axis through the center of the cube
+        void QuarterTurn(int cubie, int axis, int quarterTurns);
+
+        // Writes the model matrix of every cubie changed since the last call to instances[cubie]
+        // and appends the cubie to changed
+        void UpdateInstances(std::vector<CubieInstance>& instances, std::vector<int>& changed);
+};
@@ -1,5 +1,7 @@
 #include <Debugger.h>
 
+#include <GLExtensions.h>
+
 void GLClearError()
 {
     while (glGetError() != GL_NO_ERROR);
@@ -13,4 +15,48 @@ bool GLLogCall(const char* function, const char* file, int line)
         return false;
     }
     return true;
-}
\ No newline at end of file
+}
+
+void GLCheckFrame(const char* where)
+{
+#if GL_ERROR_CHECK >= GL_ERROR_CHECK_FRAME
+    while (GLenum error = glGetError())
+    {
+        std::cout << "[OpenGL Error] (" << error << "): during " << where << std::endl;
+    }
+#endif
+}
+
+static const char* DebugSeverityName(GLenum severity)
+{
+    switch (severity)
+    {
+        case GL_DEBUG_SEVERITY_HIGH: return "high";
+        case GL_DEBUG_SEVERITY_MEDIUM: return "medium";
+        case GL_DEBUG_SEVERITY_LOW: return "low";
+        default: return "notification";
+    }
+}
+
+// May be called on a driver thread, the message is only valid during the call
+static void APIENTRY DebugMessage(GLenum source, GLenum type, GLuint id, GLenum severity, GLsizei length, const GLchar* message, const void* userParam)
+{
+    if (severity == GL_DEBUG_SEVERITY_NOTIFICATION)
+    {
+        return;
+    }
+    const char* kind = type == GL_DEBUG_TYPE_ERROR ? "Error" : (type == GL_DEBUG_TYPE_PERFORMANCE ? "Performance" : "Debug");
+    std::cout << "[OpenGL " << kind << "] (" << DebugSeverityName(severity) << ", " << id << "): " << message << std::endl;
+}
+
+bool GLEnableDebugOutput()
+{
+    if (!GLExtensions::DebugMessageCallback)
+    {
+        return false;
+    }
+    // Not GL_DEBUG_OUTPUT_SYNCHRONOUS, the driver may report from its own threads without stalling
+    GLCall(glEnable(GL_DEBUG_OUTPUT));
+    GLCall(GLExtensions::DebugMessageCallback(DebugMessage, nullptr));
+    return true;
+}
@@ -18,9 +18,37 @@
 #define ASSERT(x) if (!(x)) raise(SIGTRAP);
 #endif
 
+// How much glGetError checking is compiled in, set with -DGL_ERROR_CHECK=<level>:
+// OFF    nothing, rely on GLEnableDebugOutput if anything
+// FRAME  one sweep per frame through GLCheckFrame, the draw path has no extra calls
+// CALL   every GLCall clears and checks the error flag (two round trips per call)
+#define GL_ERROR_CHECK_OFF 0
+#define GL_ERROR_CHECK_FRAME 1
+#define GL_ERROR_CHECK_CALL 2
+
+#ifndef GL_ERROR_CHECK
+#ifdef NDEBUG
+#define GL_ERROR_CHECK GL_ERROR_CHECK_FRAME
+#else
+#define GL_ERROR_CHECK GL_ERROR_CHECK_CALL
+#endif
+#endif
+
+#if GL_ERROR_CHECK >= GL_ERROR_CHECK_CALL
 #define GLCall(x) GLClearError();\
     x;\
     ASSERT(GLLogCall(#x, __FILE__, __LINE__));
+#else
+#define GLCall(x) x;
+#endif
 
 void GLClearError();
-bool GLLogCall(const char* function, const char* file, int line);
\ No newline at end of file
+bool GLLogCall(const char* function, const char* file, int line);
+
+// Reports the errors raised since the last check, call once per frame
+void GLCheckFrame(const char* where);
+
+// Has the driver report errors, undefined behavior and performance warnings through a
+// callback as they happen, without glGetError. Needs GL 4.3 or KHR_debug (and a debug
+// context for the most detail), returns false when unavailable.
+bool GLEnableDebugOutput();
@@ -0,0 +1,180 @@
+#include <stb/stb_image_write.h>
+
+#include <FrameEncoder.h>
+
+#include <algorithm>
+#include <iostream>
+
+FrameEncoder::FrameEncoder(int width, int height, const std::string& output, int framesPerSecond, int threadCount)
+    : m_Width(width), m_Height(height), m_Output(output), m_File(nullptr), m_Submitted(0), m_NextWrite(0), m_Stopping(false)
+{
+    m_Y4M = output.size() >= 4 && output.compare(output.size() - 4, 4, ".y4m") == 0;
+    if (m_Y4M)
+    {
+        m_File = std::fopen(output.c_str(), "wb");
+        if (!m_File)
+        {
+            std::cout << "Failed to open " << output << " for recording" << std::endl;
+            return;
+        }
+        // Full range 4:2:0, chroma sited like JPEG
+        std::fprintf(m_File, "YUV4MPEG2 W%d H%d F%d:1 Ip A1:1 C420jpeg\n", m_Width, m_Height, framesPerSecond);
+    }
+
+    if (threadCount <= 0)
+    {
+        threadCount = std::max(1, (int) std::thread::hardware_concurrency() - 1);
+    }
+    // Two frames per worker keeps every worker busy while the next frames are read back
+    for (int i = 0; i < 2 * threadCount; i++)
+    {
+        m_Buffers.emplace_back(new std::vector<unsigned char>((size_t) m_Width * m_Height * 4));
+        m_Free.push_back(m_Buffers.back().get());
+    }
+    for (int i = 0; i < threadCount; i++)
+    {
+        m_Workers.emplace_back(&FrameEncoder::Work, this);
+    }
+}
+
+FrameEncoder::~FrameEncoder()
+{
+    Finish();
+}
+
+std::vector<unsigned char>* FrameEncoder::Acquire()
+{
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    m_Freed.wait(lock, [this] { return !m_Free.empty(); });
+    std::vector<unsigned char>* pixels = m_Free.back();
+    m_Free.pop_back();
+    return pixels;
+}
+
+void FrameEncoder::Submit(std::vector<unsigned char>* pixels)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Queue.push_back({ m_Submitted++, pixels });
+    }
+    m_Queued.notify_one();
+}
+
+void FrameEncoder::Finish()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Stopping = true;
+    }
+    m_Queued.notify_all();
+    for (std::thread& worker : m_Workers)
+    {
+        worker.join();
+    }
+    m_Workers.clear();
+    if (m_File)
+    {
+        std::fclose(m_File);
+        m_File = nullptr;
+        std::cout << "Recorded " << m_NextWrite << " frames to " << m_Output << std::endl;
+    }
+}
+
+void FrameEncoder::Work()
+{
+    std::vector<unsigned char> yuv;
+    while (true)
+    {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(m_Mutex);
+            // Jobs still queued are encoded before stopping
+            m_Queued.wait(lock, [this] { return !m_Queue.empty() || m_Stopping; });
+            if (m_Queue.empty())
+            {
+                return;
+            }
+            job = m_Queue.front();
+            m_Queue.pop_front();
+        }
+
+        if (m_Y4M)
+        {
+            ConvertY4M(*job.pixels, yuv);
+        }
+        else
+        {
+            EncodePNG(job.index, *job.pixels);
+        }
+
+        std::unique_lock<std::mutex> lock(m_Mutex);
+        m_Free.push_back(job.pixels);
+        m_Freed.notify_one();
+        if (m_Y4M)
+        {
+            // Workers take jobs in order, so earlier frames are already being converted
+            m_Written.wait(lock, [this, &job] { return m_NextWrite == job.index; });
+            if (m_File)
+            {
+                std::fputs("FRAME\n", m_File);
+                std::fwrite(yuv.data(), 1, yuv.size(), m_File);
+            }
+            m_NextWrite++;
+            m_Written.notify_all();
+        }
+    }
+}
+
+void FrameEncoder::EncodePNG(int index, const std::vector<unsigned char>& pixels)
+{
+    char path[1024];
+    std::snprintf(path, sizeof(path), m_Output.c_str(), index);
+    if (!stbi_write_png(path, m_Width, m_Height, 4, pixels.data(), m_Width * 4))
+    {
+        std::cout << "Failed to write " << path << std::endl;
+    }
+}
+
+// BT.601 full range, chroma is the average of each 2x2 block
+void FrameEncoder::ConvertY4M(const std::vector<unsigned char>& pixels, std::vector<unsigned char>& yuv)
+{
+    const int chromaWidth = (m_Width + 1) / 2;
+    const int chromaHeight = (m_Height + 1) / 2;
+    yuv.resize((size_t) m_Width * m_Height + 2 * (size_t) chromaWidth * chromaHeight);
+    unsigned char* y = yuv.data();
+    unsigned char* u = y + (size_t) m_Width * m_Height;
+    unsigned char* v = u + (size_t) chromaWidth * chromaHeight;
+
+    for (int row = 0; row < m_Height; row++)
+    {
+        const unsigned char* rgba = &pixels[(size_t) row * m_Width * 4];
+        for (int x = 0; x < m_Width; x++, rgba += 4)
+        {
+            y[(size_t) row * m_Width + x] = (unsigned char) (0.299f * rgba[0] + 0.587f * rgba[1] + 0.114f * rgba[2] + 0.5f);
+        }
+    }
+    for (int row = 0; row < chromaHeight; row++)
+    {
+        for (int x = 0; x < chromaWidth; x++)
+        {
+            float r = 0.0f, g = 0.0f, b = 0.0f;
+            int count = 0;
+            for (int dy = 0; dy < 2 && 2 * row + dy < m_Height; dy++)
+            {
+                for (int dx = 0; dx < 2 && 2 * x + dx < m_Width; dx++)
+                {
+                    const unsigned char* rgba = &pixels[((size_t) (2 * row + dy) * m_Width + 2 * x + dx) * 4];
+                    r += rgba[0];
+                    g += rgba[1];
+                    b += rgba[2];
+                    count++;
+                }
+            }
+            r /= count;
+            g /= count;
+            b /= count;
+            u[(size_t) row * chromaWidth + x] = (unsigned char) std::clamp(128.0f - 0.168736f * r - 0.331264f * g + 0.5f * b + 0.5f, 0.0f, 255.0f);
+            v[(size_t) row * chromaWidth + x] = (unsigned char) std::clamp(128.0f + 0.5f * r - 0.418688f * g - 0.081312f * b + 0.5f, 0.0f, 255.0f);
+        }
+    }
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Encodes captured frames on a pool of worker threads. The output is either a numbered
+// PNG sequence (a printf pattern such as "frames/frame%05d.png") or one raw YUV4MPEG2
+// stream when it ends in .y4m, which encoders like ffmpeg read directly (a FIFO works too).
+// Frames are top row first, RGBA8.
+class FrameEncoder
+{
+    private:
+        struct Job
+        {
+            int index;
+            std::vector<unsigned char>* pixels;
+        };
+
+        int m_Width, m_Height;
+        std::string m_Output;
+        bool m_Y4M;
+        std::FILE* m_File;
+        std::vector<std::unique_ptr<std::vector<unsigned char>>> m_Buffers;
+        std::vector<std::vector<unsigned char>*> m_Free;
+        std::deque<Job> m_Queue;
+        int m_Submitted;
+        int m_NextWrite;  // Y4M frames must be written in order
+        bool m_Stopping;
+        std::mutex m_Mutex;
+        std::condition_variable m_Queued;
+        std::condition_variable m_Freed;
+        std::condition_variable m_Written;
+        std::vector<std::thread> m_Workers;
+
+        void Work();
+        void EncodePNG(int index, const std::vector<unsigned char>& pixels);
+        void ConvertY4M(const std::vector<unsigned char>& pixels, std::vector<unsigned char>& yuv);
+
+    public:
+        // threadCount 0 uses every core but one
+        FrameEncoder(int width, int height, const std::string& output, int framesPerSecond, int threadCount = 0);
+        ~FrameEncoder();
+
+        inline bool IsOpen() const { return !m_Y4M || m_File; }
+
+        // Buffer for the next frame, only blocks when the encoders fall behind by a whole pool
+        std::vector<unsigned char>* Acquire();
+        void Submit(std::vector<unsigned char>* pixels);
+        // Encodes everything submitted so far and stops the workers
+        void Finish();
+};
@@ -0,0 +1,163 @@
+#include <FrameProfiler.h>
+
+#include <Debugger.h>
+
+#include <algorithm>
+#include <iomanip>
+
+FrameProfiler::FrameProfiler()
+    : m_Frame(0)
+{
+}
+
+FrameProfiler::~FrameProfiler()
+{
+    for (const PendingQuery& pending : m_Pending)
+    {
+        m_FreeQueries.push_back(pending.query);
+    }
+    if (!m_FreeQueries.empty())
+    {
+        GLCall(glDeleteQueries((GLsizei) m_FreeQueries.size(), m_FreeQueries.data()));
+    }
+}
+
+void FrameProfiler::AddSample(const std::string& section, double milliseconds)
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    Samples& samples = m_Sections[section];
+    if ((int) samples.values.size() < History)
+    {
+        samples.values.push_back(milliseconds);
+    }
+    else
+    {
+        samples.values[samples.next] = milliseconds;
+    }
+    samples.next = (samples.next + 1) % History;
+}
+
+void FrameProfiler::BeginGpu(const std::string& section)
+{
+    unsigned int query;
+    if (m_FreeQueries.empty())
+    {
+        GLCall(glGenQueries(1, &query));
+    }
+    else
+    {
+        query = m_FreeQueries.back();
+        m_FreeQueries.pop_back();
+    }
+    GLCall(glBeginQuery(GL_TIME_ELAPSED, query));
+    m_Pending.push_back({ section, query, m_Frame });
+}
+
+void FrameProfiler::EndGpu()
+{
+    GLCall(glEndQuery(GL_TIME_ELAPSED));
+}
+
+void FrameProfiler::EndFrame()
+{
+    m_Frame++;
+    // Queries finish in order, so stop at the first one that is too new or not done yet
+    size_t collected = 0;
+    for (; collected < m_Pending.size(); collected++)
+    {
+        const PendingQuery& pending = m_Pending[collected];
+        if (m_Frame - pending.frame < QueryLatency)
+        {
+            break;
+        }
+        GLint available = 0;
+        GLCall(glGetQueryObjectiv(pending.query, GL_QUERY_RESULT_AVAILABLE, &available));
+        if (!available)
+        {
+            break;
+        }
+        GLuint64 nanoseconds = 0;
+        GLCall(glGetQueryObjectui64v(pending.query, GL_QUERY_RESULT, &nanoseconds));
+        // The first query of a context can return garbage (a raw timestamp on llvmpipe)
+        if (pending.frame > 0)
+        {
+            AddSample(pending.section, nanoseconds / 1.0e6);
+        }
+        m_FreeQueries.push_back(pending.query);
+    }
+    m_Pending.erase(m_Pending.begin(), m_Pending.begin() + collected);
+}
+
+FrameProfiler::Stats FrameProfiler::GetStats(const std::string& section) const
+{
+    Stats stats = { 0, 0.0, 0.0, 0.0, 0.0, 0.0 };
+    std::vector<double> values;
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        auto it = m_Sections.find(section);
+        if (it == m_Sections.end() || it->second.values.empty())
+        {
+            return stats;
+        }
+        values = it->second.values;
+    }
+    std::sort(values.begin(), values.end());
+    auto percentile = [&values](double p) { return values[(size_t) (p * (values.size() - 1) + 0.5)]; };
+
+    stats.count = (int) values.size();
+    for (double value : values)
+    {
+        stats.mean += value;
+    }
+    stats.mean /= values.size();
+    stats.p50 = percentile(0.50);
+    stats.p95 = percentile(0.95);
+    stats.p99 = percentile(0.99);
+    stats.max = values.back();
+    return stats;
+}
+
+std::vector<std::string> FrameProfiler::GetSections() const
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    std::vector<std::string> sections;
+    for (const auto& section : m_Sections)
+    {
+        sections.push_back(section.first);
+    }
+    return sections;
+}
+
+void FrameProfiler::Report(std::ostream& stream) const
+{
+    stream << std::fixed << std::setprecision(3);
+    stream << std::left << std::setw(14) << "section (ms)" << std::right
+           << std::setw(9) << "mean" << std::setw(9) << "p50" << std::setw(9) << "p95"
+           << std::setw(9) << "p99" << std::setw(9) << "max" << std::endl;
+    for (const std::string& section : GetSections())
+    {
+        Stats stats = GetStats(section);
+        stream << std::left << std::setw(14) << section << std::right
+               << std::setw(9) << stats.mean << std::setw(9) << stats.p50 << std::setw(9) << stats.p95
+               << std::setw(9) << stats.p99 << std::setw(9) << stats.max << std::endl;
+    }
+    stream << std::defaultfloat;
+}
+
+ProfileScope::ProfileScope(FrameProfiler* profiler, const char* section)
+    : m_Profiler(profiler), m_Section(section)
+{
+    if (m_Profiler)
+    {
+        m_Start = std::chrono::steady_clock::now();
+    }
+}
+
+ProfileScope::~ProfileScope()
+{
+    if (m_Profiler)
+    {
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - m_Start;
+        m_Profiler->AddSample(m_Section, elapsed.count());
+    }
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Rolling frame timings. CPU sections are timed with ProfileScope (from any thread),
+// GPU sections with GL_TIME_ELAPSED queries that are read back at least QueryLatency frames
+// later and only once their result is available, so reading them never stalls the pipeline. Statistics cover the last History samples
+// of each section, in milliseconds.
+class FrameProfiler
+{
+    public:
+        struct Stats
+        {
+            int count;
+            double mean, p50, p95, p99, max;
+        };
+
+        static const int History = 240;
+        static const int QueryLatency = 4;
+
+    private:
+        struct Samples
+        {
+            std::vector<double> values; // Ring of the newest samples
+            int next = 0;
+        };
+        struct PendingQuery
+        {
+            std::string section;
+            unsigned int query;
+            int frame;
+        };
+
+        mutable std::mutex m_Mutex;
+        std::map<std::string, Samples> m_Sections;
+        std::vector<PendingQuery> m_Pending; // Oldest first
+        std::vector<unsigned int> m_FreeQueries;
+        int m_Frame;
+
+    public:
+        FrameProfiler();
+        ~FrameProfiler();
+
+        void AddSample(const std::string& section, double milliseconds);
+
+        // GL thread only, GPU sections cannot be nested
+        void BeginGpu(const std::string& section);
+        void EndGpu();
+        // Call once per frame on the GL thread, collects the finished queries of QueryLatency
+        // or more frames ago, the others wait for a later frame
+        void EndFrame();
+
+        Stats GetStats(const std::string& section) const;
+        std::vector<std::string> GetSections() const;
+        void Report(std::ostream& stream) const;
+};
+
+// Adds the time until the end of the scope to a CPU section, does nothing without a profiler
+class ProfileScope
+{
+    private:
+        FrameProfiler* m_Profiler;
+        const char* m_Section;
+        std::chrono::steady_clock::time_point m_Start;
+    public:
+        ProfileScope(FrameProfiler* profiler, const char* section);
+        ~ProfileScope();
+};
@@ -0,0 +1,86 @@
+#include <FrameRecorder.h>
+
+#include <algorithm>
+
+FrameRecorder::FrameRecorder(int width, int height, const std::string& output, int framesPerSecond)
+    : m_Width(width), m_Height(height), m_Encoder(width, height, output, framesPerSecond), m_Next(0)
+{
+    GLCall(glGenBuffers(RingSize, m_Buffers));
+    for (int i = 0; i < RingSize; i++)
+    {
+        GLCall(glBindBuffer(GL_PIXEL_PACK_BUFFER, m_Buffers[i]));
+        GLCall(glBufferData(GL_PIXEL_PACK_BUFFER, (GLsizeiptr) m_Width * m_Height * 4, nullptr, GL_STREAM_READ));
+        m_Fences[i] = nullptr;
+    }
+    GLCall(glBindBuffer(GL_PIXEL_PACK_BUFFER, 0));
+}
+
+FrameRecorder::~FrameRecorder()
+{
+    Finish();
+    GLCall(glDeleteBuffers(RingSize, m_Buffers));
+}
+
+void FrameRecorder::Capture()
+{
+    int slot = m_Next;
+    m_Next = (m_Next + 1) % RingSize;
+    if (m_Fences[slot])
+    {
+        Collect(slot);
+    }
+
+    // With a pack buffer bound the read only queues a copy on the GPU
+    GLCall(glBindBuffer(GL_PIXEL_PACK_BUFFER, m_Buffers[slot]));
+    GLCall(glPixelStorei(GL_PACK_ALIGNMENT, 4));
+    GLCall(glReadPixels(0, 0, m_Width, m_Height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr));
+    GLCall(glBindBuffer(GL_PIXEL_PACK_BUFFER, 0));
+    GLCall(m_Fences[slot] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+}
+
+void FrameRecorder::Collect(int slot)
+{
+    // Issued RingSize frames ago, so this normally returns at once
+    GLCall(GLenum status = glClientWaitSync(m_Fences[slot], GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000));
+    GLCall(glDeleteSync(m_Fences[slot]));
+    m_Fences[slot] = nullptr;
+    if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED)
+    {
+        // Mapping now would block or read an unfinished copy
+        std::cout << "Recording dropped a frame, its readback did not finish" << std::endl;
+        return;
+    }
+
+    GLCall(glBindBuffer(GL_PIXEL_PACK_BUFFER, m_Buffers[slot]));
+    GLCall(const unsigned char* data = (const unsigned char*) glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, (GLsizeiptr) m_Width * m_Height * 4, GL_MAP_READ_BIT));
+    if (!data)
+    {
+        std::cout << "Recording dropped a frame, its pixel buffer could not be mapped" << std::endl;
+        GLCall(glBindBuffer(GL_PIXEL_PACK_BUFFER, 0));
+        return;
+    }
+    std::vector<unsigned char>* pixels = m_Encoder.Acquire();
+    // GL rows start at the bottom
+    const size_t rowSize = (size_t) m_Width * 4;
+    for (int y = 0; y < m_Height; y++)
+    {
+        std::copy(data + (m_Height - 1 - y) * rowSize, data + (m_Height - y) * rowSize, pixels->begin() + y * rowSize);
+    }
+    GLCall(glUnmapBuffer(GL_PIXEL_PACK_BUFFER));
+    GLCall(glBindBuffer(GL_PIXEL_PACK_BUFFER, 0));
+    m_Encoder.Submit(pixels);
+}
+
+void FrameRecorder::Finish()
+{
+    // Oldest first, so frames reach the encoder in order
+    for (int i = 0; i < RingSize; i++)
+    {
+        int slot = (m_Next + i) % RingSize;
+        if (m_Fences[slot])
+        {
+            Collect(slot);
+        }
+    }
+    m_Encoder.Finish();
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <Debugger.h>
+#include <FrameEncoder.h>
+
+#include <string>
+
+// Records every drawn frame without stalling on glReadPixels: each frame is read into the
+// next pixel buffer object of a ring and only mapped RingSize frames later, when the GPU
+// has long finished the copy. Mapped frames go to a FrameEncoder on other threads.
+// All calls must come from the thread that owns the GL context.
+class FrameRecorder
+{
+    public:
+        static const int RingSize = 3;
+
+    private:
+        int m_Width, m_Height;
+        FrameEncoder m_Encoder;
+        unsigned int m_Buffers[RingSize];
+        GLsync m_Fences[RingSize];
+        int m_Next;
+
+        // Maps a finished readback and hands it to the encoder
+        void Collect(int slot);
+
+    public:
+        FrameRecorder(int width, int height, const std::string& output, int framesPerSecond);
+        ~FrameRecorder();
+
+        inline bool IsOpen() const { return m_Encoder.IsOpen(); }
+
+        // Reads the bound read framebuffer, call after drawing and before swapping
+        void Capture();
+        // Collects the readbacks still in flight and waits for the encoders
+        void Finish();
+};
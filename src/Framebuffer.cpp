@@ -0,0 +1,84 @@
+#include <stb/stb_image_write.h>
+
+#include <Framebuffer.h>
+
+#include <iostream>
+
+Framebuffer::Framebuffer(int width, int height)
+    : m_RendererID(0), m_ColorID(0), m_DepthID(0), m_Width(width), m_Height(height)
+{
+    GLCall(glGenFramebuffers(1, &m_RendererID));
+    GLCall(glBindFramebuffer(GL_FRAMEBUFFER, m_RendererID));
+
+    GLCall(glGenRenderbuffers(1, &m_ColorID));
+    GLCall(glBindRenderbuffer(GL_RENDERBUFFER, m_ColorID));
+    GLCall(glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, m_Width, m_Height));
+    GLCall(glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, m_ColorID));
+
+    GLCall(glGenRenderbuffers(1, &m_DepthID));
+    GLCall(glBindRenderbuffer(GL_RENDERBUFFER, m_DepthID));
+    GLCall(glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, m_Width, m_Height));
+    GLCall(glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, m_DepthID));
+
+    GLCall(glBindRenderbuffer(GL_RENDERBUFFER, 0));
+    if (!IsComplete())
+    {
+        std::cout << "Framebuffer is not complete!" << std::endl;
+    }
+}
+
+Framebuffer::~Framebuffer()
+{
+    GLCall(glDeleteFramebuffers(1, &m_RendererID));
+    GLCall(glDeleteRenderbuffers(1, &m_ColorID));
+    GLCall(glDeleteRenderbuffers(1, &m_DepthID));
+}
+
+void Framebuffer::Bind() const
+{
+    GLCall(glBindFramebuffer(GL_FRAMEBUFFER, m_RendererID));
+    GLCall(glViewport(0, 0, m_Width, m_Height));
+}
+
+void Framebuffer::Unbind() const
+{
+    GLCall(glBindFramebuffer(GL_FRAMEBUFFER, 0));
+}
+
+bool Framebuffer::IsComplete() const
+{
+    GLCall(glBindFramebuffer(GL_FRAMEBUFFER, m_RendererID));
+    return glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+}
+
+void Framebuffer::ReadPixels(std::vector<unsigned char>& pixels) const
+{
+    pixels.resize((size_t) m_Width * m_Height * 4);
+    GLCall(glBindFramebuffer(GL_READ_FRAMEBUFFER, m_RendererID));
+    GLCall(glPixelStorei(GL_PACK_ALIGNMENT, 4));
+    GLCall(glReadPixels(0, 0, m_Width, m_Height, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data()));
+
+    // GL rows start at the bottom, image files at the top
+    const size_t rowSize = (size_t) m_Width * 4;
+    std::vector<unsigned char> row(rowSize);
+    for (int y = 0; y < m_Height / 2; y++)
+    {
+        unsigned char* top = &pixels[y * rowSize];
+        unsigned char* bottom = &pixels[(m_Height - 1 - y) * rowSize];
+        std::copy(top, top + rowSize, row.begin());
+        std::copy(bottom, bottom + rowSize, top);
+        std::copy(row.begin(), row.end(), bottom);
+    }
+}
+
+bool Framebuffer::SavePNG(const std::string& filepath) const
+{
+    std::vector<unsigned char> pixels;
+    ReadPixels(pixels);
+    if (!stbi_write_png(filepath.c_str(), m_Width, m_Height, 4, pixels.data(), m_Width * 4))
+    {
+        std::cout << "Failed to write " << filepath << std::endl;
+        return false;
+    }
+    return true;
+}
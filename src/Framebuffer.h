@@ -0,0 +1,30 @@
+#pragma once
+
+#include <Debugger.h>
+
+#include <string>
+#include <vector>
+
+// FBO with an RGBA8 color and a depth renderbuffer, for drawing without a window
+class Framebuffer
+{
+    private:
+        unsigned int m_RendererID;
+        unsigned int m_ColorID;
+        unsigned int m_DepthID;
+        int m_Width, m_Height;
+    public:
+        Framebuffer(int width, int height);
+        ~Framebuffer();
+
+        void Bind() const;
+        void Unbind() const;
+        bool IsComplete() const;
+
+        // Reads the color buffer top row first, 4 bytes per pixel
+        void ReadPixels(std::vector<unsigned char>& pixels) const;
+        bool SavePNG(const std::string& filepath) const;
+
+        inline int GetWidth() const { return m_Width; }
+        inline int GetHeight() const { return m_Height; }
+};
@@ -0,0 +1,73 @@
+#include <GLExtensions.h>
+
+#include <Debugger.h>
+
+PFNGLMULTIDRAWELEMENTSINDIRECTPROC GLExtensions::MultiDrawElementsIndirect = nullptr;
+PFNGLDEBUGMESSAGECALLBACKPROC GLExtensions::DebugMessageCallback = nullptr;
+PFNGLTEXSTORAGE2DPROC GLExtensions::TexStorage2D = nullptr;
+PFNGLMAXSHADERCOMPILERTHREADSKHRPROC GLExtensions::MaxShaderCompilerThreads = nullptr;
+PFNGLPROGRAMPARAMETERIPROC GLExtensions::ProgramParameteri = nullptr;
+PFNGLGETPROGRAMBINARYPROC GLExtensions::GetProgramBinary = nullptr;
+PFNGLPROGRAMBINARYPROC GLExtensions::ProgramBinary = nullptr;
+
+std::unordered_set<std::string> GLExtensions::s_Extensions;
+
+void GLExtensions::Load(GLADloadproc load)
+{
+    s_Extensions.clear();
+    int count = 0;
+    GLCall(glGetIntegerv(GL_NUM_EXTENSIONS, &count));
+    for (int i = 0; i < count; i++)
+    {
+        s_Extensions.insert((const char*) glGetStringi(GL_EXTENSIONS, i));
+    }
+
+    if (HasVersion(4, 3) || Has("GL_ARB_multi_draw_indirect"))
+    {
+        MultiDrawElementsIndirect = (PFNGLMULTIDRAWELEMENTSINDIRECTPROC) load("glMultiDrawElementsIndirect");
+    }
+    // KHR_debug names its functions without a suffix in desktop GL
+    if (HasVersion(4, 3) || Has("GL_KHR_debug"))
+    {
+        DebugMessageCallback = (PFNGLDEBUGMESSAGECALLBACKPROC) load("glDebugMessageCallback");
+    }
+    if (HasVersion(4, 2) || Has("GL_ARB_texture_storage"))
+    {
+        TexStorage2D = (PFNGLTEXSTORAGE2DPROC) load("glTexStorage2D");
+    }
+    if (Has("GL_KHR_parallel_shader_compile"))
+    {
+        MaxShaderCompilerThreads = (PFNGLMAXSHADERCOMPILERTHREADSKHRPROC) load("glMaxShaderCompilerThreadsKHR");
+    }
+    else if (Has("GL_ARB_parallel_shader_compile"))
+    {
+        MaxShaderCompilerThreads = (PFNGLMAXSHADERCOMPILERTHREADSKHRPROC) load("glMaxShaderCompilerThreadsARB");
+    }
+    if (MaxShaderCompilerThreads)
+    {
+        // Let the driver compile on as many threads as it likes, see Shader
+        GLCall(MaxShaderCompilerThreads(0xFFFFFFFF));
+    }
+    if (HasVersion(4, 1) || Has("GL_ARB_get_program_binary"))
+    {
+        ProgramParameteri = (PFNGLPROGRAMPARAMETERIPROC) load("glProgramParameteri");
+        GetProgramBinary = (PFNGLGETPROGRAMBINARYPROC) load("glGetProgramBinary");
+        ProgramBinary = (PFNGLPROGRAMBINARYPROC) load("glProgramBinary");
+    }
+}
+
+bool GLExtensions::Has(const std::string& name)
+{
+    return s_Extensions.find(name) != s_Extensions.end();
+}
+
+bool GLExtensions::HasVersion(int major, int minor)
+{
+    return GLVersion.major > major || (GLVersion.major == major && GLVersion.minor >= minor);
+}
+
+bool GLExtensions::SupportsMultiDrawIndirect()
+{
+    bool baseInstance = HasVersion(4, 2) || Has("GL_ARB_base_instance");
+    return MultiDrawElementsIndirect != nullptr && baseInstance;
+}
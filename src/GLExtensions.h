@@ -0,0 +1,61 @@
+#pragma once
+
+#include <glad/glad.h>
+
+#include <string>
+#include <unordered_set>
+
+// glad is generated for the GL 3.3 core profile only. Entry points from newer
+// versions or extensions are loaded here and stay null when the driver lacks them.
+
+#ifndef GL_DRAW_INDIRECT_BUFFER
+#define GL_DRAW_INDIRECT_BUFFER 0x8F3F
+#endif
+
+#ifndef GL_DEBUG_OUTPUT
+#define GL_DEBUG_OUTPUT 0x92E0
+#define GL_DEBUG_TYPE_ERROR 0x824C
+#define GL_DEBUG_TYPE_PERFORMANCE 0x8250
+#define GL_DEBUG_SEVERITY_HIGH 0x9146
+#define GL_DEBUG_SEVERITY_MEDIUM 0x9147
+#define GL_DEBUG_SEVERITY_LOW 0x9148
+#define GL_DEBUG_SEVERITY_NOTIFICATION 0x826B
+#endif
+
+#ifndef GL_PROGRAM_BINARY_RETRIEVABLE_HINT
+#define GL_PROGRAM_BINARY_RETRIEVABLE_HINT 0x8257
+#define GL_PROGRAM_BINARY_LENGTH 0x8741
+#define GL_NUM_PROGRAM_BINARY_FORMATS 0x87FE
+#define GL_PROGRAM_BINARY_FORMATS 0x87FF
+#endif
+
+typedef void (APIENTRYP PFNGLMAXSHADERCOMPILERTHREADSKHRPROC)(GLuint count);
+typedef void (APIENTRYP PFNGLPROGRAMPARAMETERIPROC)(GLuint program, GLenum pname, GLint value);
+typedef void (APIENTRYP PFNGLGETPROGRAMBINARYPROC)(GLuint program, GLsizei bufSize, GLsizei* length, GLenum* binaryFormat, void* binary);
+typedef void (APIENTRYP PFNGLPROGRAMBINARYPROC)(GLuint program, GLenum binaryFormat, const void* binary, GLsizei length);
+typedef void (APIENTRYP PFNGLDEBUGMESSAGECALLBACKPROC)(GLDEBUGPROC callback, const void* userParam);
+typedef void (APIENTRYP PFNGLTEXSTORAGE2DPROC)(GLenum target, GLsizei levels, GLenum internalformat, GLsizei width, GLsizei height);
+typedef void (APIENTRYP PFNGLMULTIDRAWELEMENTSINDIRECTPROC)(GLenum mode, GLenum type, const void* indirect, GLsizei drawcount, GLsizei stride);
+
+struct GLExtensions
+{
+    static PFNGLMULTIDRAWELEMENTSINDIRECTPROC MultiDrawElementsIndirect;
+    static PFNGLDEBUGMESSAGECALLBACKPROC DebugMessageCallback;  // GL 4.3 or KHR_debug
+    static PFNGLTEXSTORAGE2DPROC TexStorage2D;  // GL 4.2 or ARB_texture_storage
+    static PFNGLMAXSHADERCOMPILERTHREADSKHRPROC MaxShaderCompilerThreads;  // KHR or ARB_parallel_shader_compile
+    static PFNGLPROGRAMPARAMETERIPROC ProgramParameteri;  // GL 4.1 or ARB_get_program_binary
+    static PFNGLGETPROGRAMBINARYPROC GetProgramBinary;
+    static PFNGLPROGRAMBINARYPROC ProgramBinary;
+
+    // Call once after glad has been loaded with the same loader
+    static void Load(GLADloadproc load);
+
+    static bool Has(const std::string& name);
+    static bool HasVersion(int major, int minor);
+
+    // Multi draw indirect with a working baseInstance field (GL 4.3, or the ARB extensions)
+    static bool SupportsMultiDrawIndirect();
+
+private:
+    static std::unordered_set<std::string> s_Extensions;
+};
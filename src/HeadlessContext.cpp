@@ -0,0 +1,114 @@
+#include <HeadlessContext.h>
+
+#include <iostream>
+
+#ifdef __linux__
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+
+#ifndef EGL_PLATFORM_SURFACELESS_MESA
+#define EGL_PLATFORM_SURFACELESS_MESA 0x31DD
+#endif
+
+HeadlessContext::HeadlessContext()
+    : m_Display(EGL_NO_DISPLAY), m_Context(EGL_NO_CONTEXT)
+{
+}
+
+HeadlessContext::~HeadlessContext()
+{
+    if (m_Context != EGL_NO_CONTEXT)
+    {
+        eglMakeCurrent(m_Display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+        eglDestroyContext(m_Display, m_Context);
+    }
+    if (m_Display != EGL_NO_DISPLAY)
+    {
+        eglTerminate(m_Display);
+    }
+}
+
+bool HeadlessContext::Create(bool debug)
+{
+    // Prefer the surfaceless platform, it needs neither X11 nor a render node
+    EGLDisplay display = EGL_NO_DISPLAY;
+    PFNEGLGETPLATFORMDISPLAYEXTPROC getPlatformDisplay = (PFNEGLGETPLATFORMDISPLAYEXTPROC) eglGetProcAddress("eglGetPlatformDisplayEXT");
+    if (getPlatformDisplay)
+    {
+        display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+    }
+    if (display == EGL_NO_DISPLAY)
+    {
+        display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+    }
+    EGLint major, minor;
+    if (display == EGL_NO_DISPLAY || !eglInitialize(display, &major, &minor))
+    {
+        std::cout << "Failed to initialize EGL" << std::endl;
+        return false;
+    }
+    m_Display = display;
+
+    if (!eglBindAPI(EGL_OPENGL_API))
+    {
+        std::cout << "EGL has no desktop OpenGL support" << std::endl;
+        return false;
+    }
+
+    // No surfaces are used, any config that can render OpenGL will do
+    const EGLint configAttribs[] = { EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT, EGL_NONE };
+    EGLConfig config = nullptr;
+    EGLint configCount = 0;
+    eglChooseConfig(display, configAttribs, &config, 1, &configCount);
+
+    const EGLint contextAttribs[] = {
+        EGL_CONTEXT_MAJOR_VERSION, 3,
+        EGL_CONTEXT_MINOR_VERSION, 3,
+        EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+        EGL_CONTEXT_OPENGL_DEBUG, debug ? EGL_TRUE : EGL_FALSE,
+        EGL_NONE
+    };
+    EGLContext context = eglCreateContext(display, configCount > 0 ? config : (EGLConfig) nullptr, EGL_NO_CONTEXT, contextAttribs);
+    if (context == EGL_NO_CONTEXT)
+    {
+        std::cout << "Failed to create an EGL context (0x" << std::hex << eglGetError() << std::dec << ")" << std::endl;
+        return false;
+    }
+    m_Context = context;
+
+    if (!eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, context))
+    {
+        std::cout << "Failed to make the EGL context current" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+void* HeadlessContext::GetProcAddress(const char* name)
+{
+    return (void*) eglGetProcAddress(name);
+}
+
+#else
+
+HeadlessContext::HeadlessContext()
+    : m_Display(nullptr), m_Context(nullptr)
+{
+}
+
+HeadlessContext::~HeadlessContext()
+{
+}
+
+bool HeadlessContext::Create(bool debug)
+{
+    std::cout << "Headless rendering needs EGL and is only supported on Linux" << std::endl;
+    return false;
+}
+
+void* HeadlessContext::GetProcAddress(const char* name)
+{
+    return nullptr;
+}
+
+#endif
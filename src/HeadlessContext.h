@@ -0,0 +1,23 @@
+#pragma once
+
+#include <glad/glad.h>
+
+// GL 3.3 core context without a window or display server, created through EGL
+// (surfaceless Mesa platform when available, so llvmpipe works on GPU-less machines).
+// There is no default framebuffer, draw into a Framebuffer instead.
+class HeadlessContext
+{
+    private:
+        void* m_Display;
+        void* m_Context;
+    public:
+        HeadlessContext();
+        ~HeadlessContext();
+
+        // Creates the context and makes it current on the calling thread,
+        // debug asks for a debug context (see GLEnableDebugOutput)
+        bool Create(bool debug = false);
+
+        // Loader for gladLoadGLLoader and GLExtensions::Load
+        static void* GetProcAddress(const char* name);
+};
@@ -0,0 +1,227 @@
+#include <IdPicker.h>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <cmath>
+
+IdPicker::IdPicker(int width, int height, int size, const CubieBuffer* cubies, Shader* shader)
+    : m_Width(width), m_Height(height), m_Size(size), m_FramebufferID(0), m_ColorID(0), m_DepthID(0), m_Next(0),
+      m_Renderer(shader, nullptr), m_Cubies(cubies), m_Shader(shader), m_Requested(false), m_RequestX(0), m_RequestY(0),
+      m_Sequence(0), m_HasResult(false), m_ResultHit(false), m_Result(), m_InFlight(0)
+{
+    GLCall(glGenFramebuffers(1, &m_FramebufferID));
+    GLCall(glBindFramebuffer(GL_FRAMEBUFFER, m_FramebufferID));
+
+    GLCall(glGenRenderbuffers(1, &m_ColorID));
+    GLCall(glBindRenderbuffer(GL_RENDERBUFFER, m_ColorID));
+    GLCall(glRenderbufferStorage(GL_RENDERBUFFER, GL_R32UI, width, height));
+    GLCall(glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, m_ColorID));
+
+    GLCall(glGenRenderbuffers(1, &m_DepthID));
+    GLCall(glBindRenderbuffer(GL_RENDERBUFFER, m_DepthID));
+    GLCall(glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, width, height));
+    GLCall(glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, m_DepthID));
+
+    GLCall(GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER));
+    if (status != GL_FRAMEBUFFER_COMPLETE)
+    {
+        std::cout << "Picking framebuffer is incomplete: 0x" << std::hex << status << std::dec << std::endl;
+    }
+    GLCall(glBindRenderbuffer(GL_RENDERBUFFER, 0));
+    GLCall(glBindFramebuffer(GL_FRAMEBUFFER, 0));
+
+    GLCall(glGenBuffers(RingSize, m_Buffers));
+    for (int i = 0; i < RingSize; i++)
+    {
+        GLCall(glBindBuffer(GL_PIXEL_PACK_BUFFER, m_Buffers[i]));
+        GLCall(glBufferData(GL_PIXEL_PACK_BUFFER, sizeof(unsigned int), nullptr, GL_STREAM_READ));
+        m_Fences[i] = nullptr;
+        m_SlotSequences[i] = 0;
+    }
+    GLCall(glBindBuffer(GL_PIXEL_PACK_BUFFER, 0));
+}
+
+IdPicker::~IdPicker()
+{
+    for (int i = 0; i < RingSize; i++)
+    {
+        if (m_Fences[i])
+        {
+            GLCall(glDeleteSync(m_Fences[i]));
+        }
+    }
+    GLCall(glDeleteBuffers(RingSize, m_Buffers));
+    GLCall(glDeleteRenderbuffers(1, &m_DepthID));
+    GLCall(glDeleteRenderbuffers(1, &m_ColorID));
+    GLCall(glDeleteFramebuffers(1, &m_FramebufferID));
+}
+
+void IdPicker::Request(int x, int y)
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_RequestX = x;
+    m_RequestY = y;
+    m_Sequence++;
+    m_Requested = true;
+    m_HasResult = false;
+}
+
+bool IdPicker::Poll(bool& hit, PickResult& result)
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    if (!m_HasResult)
+    {
+        return false;
+    }
+    hit = m_ResultHit;
+    result = m_Result;
+    m_HasResult = false;
+    return true;
+}
+
+void IdPicker::Update(const SceneSnapshot& scene)
+{
+    // Oldest slot first, stale results are dropped in Collect
+    for (int i = 0; i < RingSize; i++)
+    {
+        int slot = (m_Next + i) % RingSize;
+        if (m_Fences[slot] && !Collect(slot))
+        {
+            break;
+        }
+    }
+
+    int x, y;
+    unsigned int sequence;
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        if (!m_Requested)
+        {
+            return;
+        }
+        x = m_RequestX;
+        y = m_Height - 1 - m_RequestY;
+        sequence = m_Sequence;
+        m_Requested = false;
+    }
+    if (m_Fences[m_Next] || x < 0 || y < 0 || x >= m_Width || y >= m_Height)
+    {
+        // Every slot is in flight or the pixel is outside, report a miss
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_ResultHit = false;
+        m_HasResult = true;
+        return;
+    }
+    Draw(scene, x, y);
+
+    // Queue the copy of the one pixel, it runs after the draw without blocking
+    GLCall(glBindFramebuffer(GL_READ_FRAMEBUFFER, m_FramebufferID));
+    GLCall(glBindBuffer(GL_PIXEL_PACK_BUFFER, m_Buffers[m_Next]));
+    GLCall(glReadPixels(x, y, 1, 1, GL_RED_INTEGER, GL_UNSIGNED_INT, nullptr));
+    GLCall(glBindBuffer(GL_PIXEL_PACK_BUFFER, 0));
+    GLCall(glBindFramebuffer(GL_READ_FRAMEBUFFER, 0));
+    GLCall(m_Fences[m_Next] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+    m_SlotSequences[m_Next] = sequence;
+    m_InFlight++;
+    m_Next = (m_Next + 1) % RingSize;
+}
+
+void IdPicker::Draw(const SceneSnapshot& scene, int x, int y)
+{
+    int framebuffer, viewport[4];
+    GLCall(glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &framebuffer));
+    GLCall(glGetIntegerv(GL_VIEWPORT, viewport));
+    GLCall(glBindFramebuffer(GL_DRAW_FRAMEBUFFER, m_FramebufferID));
+    GLCall(glViewport(0, 0, m_Width, m_Height));
+
+    // Only the requested pixel is cleared and shaded
+    GLCall(glEnable(GL_SCISSOR_TEST));
+    GLCall(glScissor(x, y, 1, 1));
+    GLCall(glDisable(GL_BLEND));
+    GLuint background[4] = { 0, 0, 0, 0 };
+    GLCall(glClearBufferuiv(GL_COLOR, 0, background));
+    GLCall(glClear(GL_DEPTH_BUFFER_BIT));
+
+    if (m_Cubies->GetCount() > 0)
+    {
+        m_Shader->Bind();
+        m_Shader->SetUniformMat4f("u_MVP", scene.mvp);
+        m_Shader->SetUniform1i("u_Cubies", ProceduralCubeRenderer::CubieTextureSlot);
+        scene.turns.SetUniforms(m_Shader);
+        m_Renderer.DrawInstances(*m_Cubies);
+    }
+
+    GLCall(glEnable(GL_BLEND));
+    GLCall(glDisable(GL_SCISSOR_TEST));
+    GLCall(glBindFramebuffer(GL_DRAW_FRAMEBUFFER, framebuffer));
+    GLCall(glViewport(viewport[0], viewport[1], viewport[2], viewport[3]));
+}
+
+// Outward normal of each face of the cubie mesh, in sticker face order
+static const glm::vec3 faceNormals[6] = {
+    { 0.0f, 0.0f, 1.0f }, { 0.0f, 0.0f, -1.0f }, { -1.0f, 0.0f, 0.0f },
+    { 1.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f }, { 0.0f, -1.0f, 0.0f }
+};
+
+bool IdPicker::Collect(int slot)
+{
+    GLCall(GLenum status = glClientWaitSync(m_Fences[slot], 0, 0));
+    if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED)
+    {
+        return false;
+    }
+    GLCall(glDeleteSync(m_Fences[slot]));
+    m_Fences[slot] = nullptr;
+    m_InFlight--;
+
+    unsigned int id = 0;
+    GLCall(glBindBuffer(GL_PIXEL_PACK_BUFFER, m_Buffers[slot]));
+    GLCall(const unsigned int* pixel = (const unsigned int*) glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, sizeof(unsigned int), GL_MAP_READ_BIT));
+    if (pixel)
+    {
+        id = *pixel;
+        GLCall(glUnmapBuffer(GL_PIXEL_PACK_BUFFER));
+    }
+    GLCall(glBindBuffer(GL_PIXEL_PACK_BUFFER, 0));
+
+    // The ID names a cubie of an earlier frame, it is placed where the cubie rests now
+    const std::vector<CubieInstance>& cubies = m_Cubies->GetCubies();
+    PickResult result = {};
+    bool hit = id > 0 && (id - 1) / 8 < cubies.size() && (id - 1) % 8 < 6;
+    if (hit)
+    {
+        const glm::mat4& model = cubies[(id - 1) / 8].model;
+        glm::vec3 center = glm::vec3(model[3]) + glm::vec3(m_Size / 2.0f);
+        glm::vec3 normal = glm::mat3(model) * faceNormals[(id - 1) % 8];
+        int axis = 0;
+        for (int i = 1; i < 3; i++)
+        {
+            if (std::abs(normal[i]) > std::abs(normal[axis]))
+            {
+                axis = i;
+            }
+        }
+        for (int i = 0; i < 3; i++)
+        {
+            result.cubie[i] = std::min(std::max((int) std::floor(center[i]), 0), m_Size - 1);
+        }
+        result.normalAxis = axis;
+        result.normalSign = normal[axis] > 0.0f ? 1 : -1;
+        result.face = FaceFromNormal(axis, result.normalSign);
+        result.point = glm::vec3(result.cubie) + glm::vec3(0.5f);
+        result.point[axis] += 0.5f * result.normalSign;
+        // Inner faces only show through the gap of a turning layer, they have no sticker
+        hit = result.cubie[axis] == (result.normalSign > 0 ? m_Size - 1 : 0);
+    }
+
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    if (m_SlotSequences[slot] != m_Sequence)
+    {
+        // Read back for a press that has since been replaced, it must not answer the new one
+        return true;
+    }
+    m_ResultHit = hit;
+    m_Result = result;
+    m_HasResult = true;
+    return true;
+}
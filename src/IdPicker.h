@@ -0,0 +1,66 @@
+#pragma once
+
+#include <Debugger.h>
+#include <CubieBuffer.h>
+#include <Picking.h>
+#include <ProceduralCubeRenderer.h>
+#include <SceneBuffer.h>
+#include <Shader.h>
+
+#include <atomic>
+#include <mutex>
+
+// Picking on the GPU, for scenes where ray casting every object on the CPU gets expensive.
+// A requested pixel is drawn again into an R32UI target holding cubie index and face
+// (the PICKING variant of cube.shader, scissored to that pixel), read into the next pixel
+// buffer object of a ring and only mapped once its fence has signaled, one or two frames
+// later. Neither thread ever waits on glReadPixels.
+// Request and Poll may be called from any thread, Update only from the one drawing.
+class IdPicker
+{
+    public:
+        static const int RingSize = 3;
+
+    private:
+        int m_Width, m_Height;
+        int m_Size;
+        unsigned int m_FramebufferID;
+        unsigned int m_ColorID;
+        unsigned int m_DepthID;
+        unsigned int m_Buffers[RingSize];
+        GLsync m_Fences[RingSize];
+        unsigned int m_SlotSequences[RingSize]; // Request read back in each slot
+        int m_Next;
+        ProceduralCubeRenderer m_Renderer;
+        const CubieBuffer* m_Cubies; // The cubies as drawn, shared with the scene
+        Shader* m_Shader;
+
+        std::mutex m_Mutex;
+        std::atomic<bool> m_Requested;
+        int m_RequestX, m_RequestY;
+        unsigned int m_Sequence; // Counts requests, only a result for the latest is reported
+        bool m_HasResult;
+        bool m_ResultHit;
+        PickResult m_Result;
+        std::atomic<int> m_InFlight;
+
+        void Draw(const SceneSnapshot& scene, int x, int y);
+        // Maps the slot when its readback has finished, returns false while it is still running
+        bool Collect(int slot);
+
+    public:
+        // width and height of the framebuffer the scene is drawn to, size of the cube
+        IdPicker(int width, int height, int size, const CubieBuffer* cubies, Shader* shader);
+        ~IdPicker();
+
+        // Pixel in framebuffer coordinates, top row first like cursor positions
+        void Request(int x, int y);
+        // A request is waiting to be drawn or read back, keep drawing frames until it is done
+        inline bool IsBusy() const { return m_Requested || m_InFlight > 0; }
+        // Takes the newest finished result, the point of the result is not filled in
+        bool Poll(bool& hit, PickResult& result);
+
+        // Call once per drawn frame with its snapshot, after the scene itself was drawn and
+        // the CubieBuffer brought up to date
+        void Update(const SceneSnapshot& scene);
+};
@@ -1,13 +1,34 @@
 #include <IndexBuffer.h>
 
+#include <limits>
+#include <vector>
+
 IndexBuffer::IndexBuffer(const unsigned int* data, unsigned int size)
-    : m_Count(size / sizeof(unsigned int))
+    : m_Count(size / sizeof(unsigned int)), m_Capacity(m_Count), m_Type(GL_UNSIGNED_INT)
 {
     ASSERT(sizeof(unsigned int) == sizeof(GLuint));
+    Create(data, size);
+}
+
+IndexBuffer::IndexBuffer(const unsigned short* data, unsigned int size)
+    : m_Count(size / sizeof(unsigned short)), m_Capacity(m_Count), m_Type(GL_UNSIGNED_SHORT)
+{
+    Create(data, size);
+}
 
+IndexBuffer::IndexBuffer(const unsigned char* data, unsigned int size)
+    : m_Count(size), m_Capacity(m_Count), m_Type(GL_UNSIGNED_BYTE)
+{
+    Create(data, size);
+}
+
+// Goes through the copy target so the index binding of whatever vertex array is bound stays intact
+IndexBuffer::IndexBuffer(unsigned int capacity, unsigned int type)
+    : m_Count(0), m_Capacity(capacity), m_Type(type)
+{
     GLCall(glGenBuffers(1, &m_RendererID));
-    GLCall(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_RendererID));
-    GLCall(glBufferData(GL_ELEMENT_ARRAY_BUFFER, size, data, GL_STATIC_DRAW));
+    GLCall(glBindBuffer(GL_COPY_WRITE_BUFFER, m_RendererID));
+    GLCall(glBufferData(GL_COPY_WRITE_BUFFER, capacity * GetIndexSize(), nullptr, GL_STATIC_DRAW));
 }
 
 IndexBuffer::~IndexBuffer()
@@ -15,6 +36,86 @@ IndexBuffer::~IndexBuffer()
     GLCall(glDeleteBuffers(1, &m_RendererID));
 }
 
+void IndexBuffer::Create(const void* data, unsigned int size)
+{
+    GLCall(glGenBuffers(1, &m_RendererID));
+    GLCall(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_RendererID));
+    GLCall(glBufferData(GL_ELEMENT_ARRAY_BUFFER, size, data, GL_STATIC_DRAW));
+}
+
+unsigned int IndexBuffer::GetIndexSize(unsigned int type)
+{
+    switch (type)
+    {
+    case GL_UNSIGNED_INT:
+        return 4;
+    case GL_UNSIGNED_SHORT:
+        return 2;
+    case GL_UNSIGNED_BYTE:
+        return 1;
+    }
+    ASSERT(false);
+    return 0;
+}
+
+unsigned int IndexBuffer::Allocate(unsigned int count)
+{
+    ASSERT(m_Count + count <= m_Capacity);
+    unsigned int first = m_Count;
+    m_Count += count;
+    return first;
+}
+
+template<typename Out, typename In>
+static std::vector<Out> Narrow(const In* data, unsigned int count)
+{
+    std::vector<Out> indices(count);
+    for (unsigned int i = 0; i < count; i++)
+    {
+        ASSERT(data[i] <= std::numeric_limits<Out>::max());
+        indices[i] = (Out) data[i];
+    }
+    return indices;
+}
+
+template<typename In>
+static void Upload(unsigned int type, unsigned int offset, const In* data, unsigned int count)
+{
+    if (type == GL_UNSIGNED_SHORT && sizeof(In) != sizeof(unsigned short))
+    {
+        std::vector<unsigned short> indices = Narrow<unsigned short>(data, count);
+        GLCall(glBufferSubData(GL_COPY_WRITE_BUFFER, offset, count * sizeof(unsigned short), indices.data()));
+    }
+    else if (type == GL_UNSIGNED_BYTE)
+    {
+        std::vector<unsigned char> indices = Narrow<unsigned char>(data, count);
+        GLCall(glBufferSubData(GL_COPY_WRITE_BUFFER, offset, count, indices.data()));
+    }
+    else if (type == GL_UNSIGNED_INT && sizeof(In) != sizeof(unsigned int))
+    {
+        std::vector<unsigned int> indices(data, data + count);
+        GLCall(glBufferSubData(GL_COPY_WRITE_BUFFER, offset, count * sizeof(unsigned int), indices.data()));
+    }
+    else
+    {
+        GLCall(glBufferSubData(GL_COPY_WRITE_BUFFER, offset, count * sizeof(In), data));
+    }
+}
+
+void IndexBuffer::SubData(unsigned int first, const unsigned int* data, unsigned int count)
+{
+    ASSERT(first + count <= m_Capacity);
+    GLCall(glBindBuffer(GL_COPY_WRITE_BUFFER, m_RendererID));
+    Upload(m_Type, first * GetIndexSize(), data, count);
+}
+
+void IndexBuffer::SubData(unsigned int first, const unsigned short* data, unsigned int count)
+{
+    ASSERT(first + count <= m_Capacity);
+    GLCall(glBindBuffer(GL_COPY_WRITE_BUFFER, m_RendererID));
+    Upload(m_Type, first * GetIndexSize(), data, count);
+}
+
 void IndexBuffer::Bind() const
 {
     GLCall(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_RendererID));
@@ -23,4 +124,4 @@ void IndexBuffer::Bind() const
 void IndexBuffer::Unbind() const
 {
     GLCall(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0));
-}
\ No newline at end of file
+}
@@ -2,18 +2,38 @@
 
 #include <Debugger.h>
 
-// EBO
+// EBO, with 32, 16 or 8 bit indices (GL_UNSIGNED_INT, GL_UNSIGNED_SHORT, GL_UNSIGNED_BYTE).
+// 16 bit indices halve the index fetch for meshes up to 65536 vertices, 8 bit indices are
+// smaller still but some GPUs convert them on the CPU, so prefer 16 bit for draw paths.
 class IndexBuffer
 {
     private:
         unsigned int m_RendererID;
         unsigned int m_Count;
+        unsigned int m_Capacity;
+        unsigned int m_Type;
+
+        void Create(const void* data, unsigned int size);
     public:
         IndexBuffer(const unsigned int* data, unsigned int size);
+        IndexBuffer(const unsigned short* data, unsigned int size);
+        IndexBuffer(const unsigned char* data, unsigned int size);
+        // Empty buffer for capacity indices of the given type that is filled through Allocate/SubData
+        IndexBuffer(unsigned int capacity, unsigned int type = GL_UNSIGNED_INT);
         ~IndexBuffer();
 
+        // Reserves count indices after the used ones and returns the first index
+        unsigned int Allocate(unsigned int count);
+        // Narrows the indices to the buffer's type, they have to fit
+        void SubData(unsigned int first, const unsigned int* data, unsigned int count);
+        void SubData(unsigned int first, const unsigned short* data, unsigned int count);
+
         void Bind() const;
         void Unbind() const;
 
         inline unsigned int GetCount() const { return m_Count; }
-};
\ No newline at end of file
+        inline unsigned int GetType() const { return m_Type; }
+        inline unsigned int GetIndexSize() const { return GetIndexSize(m_Type); }
+
+        static unsigned int GetIndexSize(unsigned int type);
+};
@@ -0,0 +1,76 @@
+#include <LayerTurns.h>
+
+#include <Shader.h>
+
+#include <cmath>
+
+LayerTurns::LayerTurns()
+    : axis(0), gridOffset(0.0f), count(0)
+{
+}
+
+void LayerTurns::Clear(int turnAxis, float offset)
+{
+    axis = turnAxis;
+    gridOffset = offset;
+    count = 0;
+    overflow.clear();
+}
+
+void LayerTurns::Add(int first, int last, float radians)
+{
+    glm::vec3 turn((float) first, (float) last, radians);
+    if (count < MaxTurns)
+    {
+        turns[count++] = turn;
+    }
+    else
+    {
+        overflow.push_back(turn);
+    }
+}
+
+static const glm::vec3* FindTurn(const glm::vec3* turns, int count, float layer)
+{
+    for (int i = 0; i < count; i++)
+    {
+        if (layer > turns[i].x - 0.5f && layer < turns[i].y + 0.5f)
+        {
+            return &turns[i];
+        }
+    }
+    return nullptr;
+}
+
+bool LayerTurns::GetOverflowTurn(const glm::mat4& model, float& radians) const
+{
+    const glm::vec3* turn = FindTurn(overflow.data(), (int) overflow.size(), model[3][axis] + gridOffset);
+    if (turn)
+    {
+        radians = turn->z;
+    }
+    return turn != nullptr;
+}
+
+glm::mat4 LayerTurns::Rotate(const glm::mat4& model, int axis, float radians)
+{
+    // A turn about a main axis only mixes the two other rows
+    const int a = (axis + 1) % 3, b = (axis + 2) % 3;
+    const float c = std::cos(radians), s = std::sin(radians);
+    glm::mat4 result = model;
+    for (int column = 0; column < 4; column++)
+    {
+        const float u = model[column][a], v = model[column][b];
+        result[column][a] = c * u - s * v;
+        result[column][b] = s * u + c * v;
+    }
+    return result;
+}
+
+void LayerTurns::SetUniforms(Shader* shader) const
+{
+    shader->SetUniform1i("u_TurnAxis", axis);
+    shader->SetUniform1f("u_GridOffset", gridOffset);
+    shader->SetUniform1i("u_TurnCount", count);
+    shader->SetUniform3fv("u_Turns", turns, MaxTurns);
+}
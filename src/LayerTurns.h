@@ -0,0 +1,31 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <vector>
+
+class Shader;
+
+// Walls turned away from their rest position, all about the locked axis. Cubie matrices stay
+// at rest and the vertex shader turns every cubie whose layer is in one of the ranges
+// (include/turns.glsl), so a turning wall costs the CPU the same for any cube size.
+struct LayerTurns
+{
+    static const int MaxTurns = 8;  // maxTurns in include/turns.glsl
+
+    int axis;
+    float gridOffset;               // Rest position along axis plus gridOffset is the layer
+    int count;
+    glm::vec3 turns[MaxTurns];      // First layer, last layer, radians
+    std::vector<glm::vec3> overflow; // Ranges past MaxTurns, CubieBuffer turns these cubies
+
+    LayerTurns();
+
+    void Clear(int turnAxis, float offset);
+    void Add(int first, int last, float radians);
+
+    // True when the cubie is in one of the overflow ranges, radians is that range's angle
+    bool GetOverflowTurn(const glm::mat4& model, float& radians) const;
+    static glm::mat4 Rotate(const glm::mat4& model, int axis, float radians);
+    void SetUniforms(Shader* shader) const;
+};
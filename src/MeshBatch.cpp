@@ -0,0 +1,120 @@
+#include <MeshBatch.h>
+#include <GLExtensions.h>
+
+MeshBatch::MeshBatch(const VertexBufferLayout& vertexLayout, const VertexBufferLayout& instanceLayout, unsigned int vertexSize, unsigned int indexCount, unsigned int indexType)
+    : m_VertexLayout(vertexLayout), m_InstanceLayout(instanceLayout),
+      m_Vertices(vertexSize), m_Indices(indexCount, indexType), m_Instances(instanceLayout.GetStride() * 64),
+      m_InstanceAttrib(0), m_IndirectID(0), m_MultiDrawIndirect(GLExtensions::SupportsMultiDrawIndirect()), m_InstanceCount(0)
+{
+    m_VA.AddBuffer(m_Vertices, m_VertexLayout);
+    m_InstanceAttrib = m_VA.AddBuffer(m_Instances, m_InstanceLayout, 1);
+    m_Indices.Bind();
+    m_VA.Unbind();
+
+    if (m_MultiDrawIndirect)
+    {
+        GLCall(glGenBuffers(1, &m_IndirectID));
+    }
+}
+
+MeshBatch::~MeshBatch()
+{
+    if (m_IndirectID)
+    {
+        GLCall(glDeleteBuffers(1, &m_IndirectID));
+    }
+}
+
+MeshHandle MeshBatch::AddMesh(const void* vertices, unsigned int size, const unsigned int* indices, unsigned int count)
+{
+    return AddMeshIndices(vertices, size, indices, count);
+}
+
+MeshHandle MeshBatch::AddMesh(const void* vertices, unsigned int size, const unsigned short* indices, unsigned int count)
+{
+    return AddMeshIndices(vertices, size, indices, count);
+}
+
+template<typename T>
+MeshHandle MeshBatch::AddMeshIndices(const void* vertices, unsigned int size, const T* indices, unsigned int count)
+{
+    unsigned int stride = m_VertexLayout.GetStride();
+    ASSERT(size % stride == 0);
+
+    unsigned int offset = m_Vertices.Allocate(size);
+    m_Vertices.SubData(offset, vertices, size);
+    unsigned int firstIndex = m_Indices.Allocate(count);
+    m_Indices.SubData(firstIndex, indices, count);
+
+    return { firstIndex, count, (int) (offset / stride) };
+}
+
+void* MeshBatch::Draw(const MeshHandle& mesh, unsigned int instanceCount)
+{
+    unsigned int stride = m_InstanceLayout.GetStride();
+    unsigned int offset = m_InstanceCount * stride;
+    m_Commands.push_back({ mesh.indexCount, instanceCount, mesh.firstIndex, mesh.baseVertex, m_InstanceCount });
+    m_CommandInstances.push_back(&m_Instances);
+    m_InstanceCount += instanceCount;
+    m_InstanceData.resize(m_InstanceCount * stride);
+    return m_InstanceData.data() + offset;
+}
+
+void MeshBatch::Draw(const MeshHandle& mesh, const VertexBuffer& instances, unsigned int instanceCount)
+{
+    m_Commands.push_back({ mesh.indexCount, instanceCount, mesh.firstIndex, mesh.baseVertex, 0 });
+    m_CommandInstances.push_back(&instances);
+}
+
+void MeshBatch::Submit()
+{
+    if (m_Commands.empty())
+    {
+        return;
+    }
+
+    if (m_InstanceCount > 0)
+    {
+        m_Instances.SetData(m_InstanceData.data(), m_InstanceData.size());
+    }
+    m_VA.Bind();
+    if (m_MultiDrawIndirect)
+    {
+        GLCall(glBindBuffer(GL_DRAW_INDIRECT_BUFFER, m_IndirectID));
+        GLCall(glBufferData(GL_DRAW_INDIRECT_BUFFER, m_Commands.size() * sizeof(DrawElementsIndirectCommand), m_Commands.data(), GL_DYNAMIC_DRAW));
+        size_t first = 0;
+        while (first < m_Commands.size())
+        {
+            size_t last = first;
+            while (last + 1 < m_Commands.size() && m_CommandInstances[last + 1] == m_CommandInstances[first])
+            {
+                last++;
+            }
+            m_VA.PointBuffer(m_InstanceAttrib, *m_CommandInstances[first], m_InstanceLayout, 1, 0);
+            GLCall(GLExtensions::MultiDrawElementsIndirect(GL_TRIANGLES, m_Indices.GetType(), (const void*) (first * sizeof(DrawElementsIndirectCommand)), last - first + 1, 0));
+            first = last + 1;
+        }
+        GLCall(glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0));
+    }
+    else
+    {
+        // GL 3.3 has no base instance, so the instance attributes are moved instead
+        unsigned int stride = m_InstanceLayout.GetStride();
+        for (size_t i = 0; i < m_Commands.size(); i++)
+        {
+            const DrawElementsIndirectCommand& command = m_Commands[i];
+            if (command.instanceCount == 0)
+            {
+                continue;
+            }
+            m_VA.PointBuffer(m_InstanceAttrib, *m_CommandInstances[i], m_InstanceLayout, 1, command.baseInstance * stride);
+            GLCall(glDrawElementsInstancedBaseVertex(GL_TRIANGLES, command.count, m_Indices.GetType(), (const void*) (uintptr_t) (command.firstIndex * m_Indices.GetIndexSize()), command.instanceCount, command.baseVertex));
+        }
+    }
+    m_VA.PointBuffer(m_InstanceAttrib, m_Instances, m_InstanceLayout, 1, 0);
+
+    m_Commands.clear();
+    m_CommandInstances.clear();
+    m_InstanceData.clear();
+    m_InstanceCount = 0;
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <Debugger.h>
+#include <VertexArray.h>
+#include <VertexBuffer.h>
+#include <VertexBufferLayout.h>
+#include <IndexBuffer.h>
+
+#include <vector>
+
+// Where a mesh lives inside the shared buffers of a MeshBatch
+struct MeshHandle
+{
+    unsigned int firstIndex;
+    unsigned int indexCount;
+    int baseVertex;
+};
+
+// Layout of one glMultiDrawElementsIndirect command
+struct DrawElementsIndirectCommand
+{
+    unsigned int count;
+    unsigned int instanceCount;
+    unsigned int firstIndex;
+    int baseVertex;
+    unsigned int baseInstance;
+};
+
+// Packs every mesh into one vertex and one index buffer and collects instanced draws
+// that are submitted together: with one glMultiDrawElementsIndirect call when the driver
+// supports it, otherwise with a glDrawElementsInstancedBaseVertex loop (GL 3.3).
+class MeshBatch
+{
+    private:
+        VertexBufferLayout m_VertexLayout;
+        VertexBufferLayout m_InstanceLayout;
+        VertexArray m_VA;
+        VertexBuffer m_Vertices;
+        IndexBuffer m_Indices;
+        VertexBuffer m_Instances;
+        unsigned int m_InstanceAttrib;
+        unsigned int m_IndirectID;
+        bool m_MultiDrawIndirect;
+
+        template<typename T>
+        MeshHandle AddMeshIndices(const void* vertices, unsigned int size, const T* indices, unsigned int count);
+
+        std::vector<DrawElementsIndirectCommand> m_Commands;
+        std::vector<const VertexBuffer*> m_CommandInstances; // Instance buffer of each command
+        std::vector<unsigned char> m_InstanceData;
+        unsigned int m_InstanceCount;
+
+    public:
+        // vertexSize is the capacity in bytes, indexCount in indices. Indices are relative to their
+        // mesh (baseVertex), so 16 bit indices work as long as no single mesh needs more.
+        MeshBatch(const VertexBufferLayout& vertexLayout, const VertexBufferLayout& instanceLayout, unsigned int vertexSize, unsigned int indexCount, unsigned int indexType = GL_UNSIGNED_INT);
+        ~MeshBatch();
+
+        MeshHandle AddMesh(const void* vertices, unsigned int size, const unsigned int* indices, unsigned int count);
+        MeshHandle AddMesh(const void* vertices, unsigned int size, const unsigned short* indices, unsigned int count);
+
+        // Queues instanceCount instances of the mesh and returns the memory for their
+        // instance data, which stays valid until the next Draw or Submit
+        void* Draw(const MeshHandle& mesh, unsigned int instanceCount);
+        // Queues instanceCount instances of the mesh whose data the caller keeps in its own
+        // buffer across frames, laid out like the batch's instances
+        void Draw(const MeshHandle& mesh, const VertexBuffer& instances, unsigned int instanceCount);
+        // Uploads the instance data and issues every queued draw, one multi draw per run of
+        // commands that read the same instance buffer
+        void Submit();
+
+        inline bool UsesMultiDrawIndirect() const { return m_MultiDrawIndirect; }
+        inline const VertexArray& GetVertexArray() const { return m_VA; }
+};
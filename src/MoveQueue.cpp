@@ -0,0 +1,56 @@
+#include <MoveQueue.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+
+void MoveQueue::Push(const WallMove& move)
+{
+    if (move.degrees == 0.0f)
+    {
+        return;
+    }
+    for (auto it = m_Moves.rbegin(); it != m_Moves.rend() && it->axis == move.axis; ++it)
+    {
+        if (it->layer != move.layer)
+        {
+            continue;
+        }
+
+        // Keep the faster of the two turn speeds for the composed turn
+        float secondsPerDegree = move.duration / std::abs(move.degrees);
+        if (it->degrees != 0.0f)
+        {
+            secondsPerDegree = std::min(secondsPerDegree, it->duration / std::abs(it->degrees));
+        }
+        it->degrees = NormalizeDegrees(it->degrees + move.degrees);
+        it->duration = std::abs(it->degrees) * secondsPerDegree;
+        if (it->degrees == 0.0f)
+        {
+            m_Moves.erase(std::next(it).base());
+        }
+        return;
+    }
+    m_Moves.push_back(move);
+}
+
+WallMove MoveQueue::Pop()
+{
+    WallMove move = m_Moves.front();
+    m_Moves.pop_front();
+    return move;
+}
+
+float MoveQueue::NormalizeDegrees(float degrees)
+{
+    degrees = std::fmod(degrees, 360.0f);
+    if (degrees <= -180.0f)
+    {
+        degrees += 360.0f;
+    }
+    else if (degrees > 180.0f)
+    {
+        degrees -= 360.0f;
+    }
+    return degrees;
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <WallMove.h>
+
+#include <deque>
+
+// Pending wall turns between input and animation. A pushed move is merged with an
+// earlier move of the same layer when only turns around the same axis lie between
+// them (those commute), so R R -> R2, R R' -> nothing and R2 R2 -> nothing, and a
+// long backlog on one axis collapses into one turn per layer.
+class MoveQueue
+{
+    private:
+        std::deque<WallMove> m_Moves;
+
+    public:
+        void Push(const WallMove& move);
+        WallMove Pop();
+        inline const WallMove& Peek() const { return m_Moves.front(); }
+
+        inline bool Empty() const { return m_Moves.empty(); }
+        inline int Size() const { return (int) m_Moves.size(); }
+        inline void Clear() { m_Moves.clear(); }
+
+        // Wraps an angle into (-180, 180], the shortest turn with the same result
+        static float NormalizeDegrees(float degrees);
+};
@@ -0,0 +1,122 @@
+#include <Picking.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+int FaceFromNormal(int axis, int sign)
+{
+    // Sticker face order: F(+z) B(-z) L(-x) R(+x) U(+y) D(-y)
+    switch (axis)
+    {
+    case 0:
+        return sign > 0 ? 3 : 2;
+    case 1:
+        return sign > 0 ? 4 : 5;
+    default:
+        return sign > 0 ? 0 : 1;
+    }
+}
+
+// Only the outer shell of cells holds cubies
+static bool IsCubie(const glm::ivec3& cell, int size)
+{
+    for (int axis = 0; axis < 3; axis++)
+    {
+        if (cell[axis] == 0 || cell[axis] == size - 1)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool PickGrid(const Ray& ray, int size, PickResult& result)
+{
+    const float infinity = std::numeric_limits<float>::infinity();
+
+    // Slab test against [0, size]^3, remembering the axis the ray enters through
+    float tNear = 0.0f;
+    float tFar = infinity;
+    int entryAxis = -1;
+    for (int axis = 0; axis < 3; axis++)
+    {
+        float origin = ray.origin[axis];
+        float direction = ray.direction[axis];
+        if (direction == 0.0f)
+        {
+            if (origin < 0.0f || origin > (float) size)
+            {
+                return false;
+            }
+            continue;
+        }
+        float t0 = (0.0f - origin) / direction;
+        float t1 = ((float) size - origin) / direction;
+        if (t0 > t1)
+        {
+            std::swap(t0, t1);
+        }
+        if (t0 > tNear)
+        {
+            tNear = t0;
+            entryAxis = axis;
+        }
+        tFar = std::min(tFar, t1);
+        if (tNear > tFar)
+        {
+            return false;
+        }
+    }
+
+    glm::vec3 entry = ray.origin + tNear * ray.direction;
+    glm::ivec3 cell;
+    glm::ivec3 step;
+    glm::vec3 tMax, tDelta;
+    for (int axis = 0; axis < 3; axis++)
+    {
+        cell[axis] = std::min(std::max((int) std::floor(entry[axis]), 0), size - 1);
+        float direction = ray.direction[axis];
+        step[axis] = direction > 0.0f ? 1 : (direction < 0.0f ? -1 : 0);
+        if (step[axis] == 0)
+        {
+            tMax[axis] = infinity;
+            tDelta[axis] = infinity;
+            continue;
+        }
+        // Parameter of the next cell boundary on this axis and the distance between boundaries
+        float boundary = (float) (cell[axis] + (step[axis] > 0 ? 1 : 0));
+        tMax[axis] = (boundary - ray.origin[axis]) / direction;
+        tDelta[axis] = 1.0f / std::abs(direction);
+    }
+
+    int axis = entryAxis;
+    float t = tNear;
+    while (!IsCubie(cell, size))
+    {
+        axis = tMax.x < tMax.y ? (tMax.x < tMax.z ? 0 : 2) : (tMax.y < tMax.z ? 1 : 2);
+        t = tMax[axis];
+        cell[axis] += step[axis];
+        if (cell[axis] < 0 || cell[axis] >= size)
+        {
+            return false;
+        }
+        tMax[axis] += tDelta[axis];
+    }
+
+    result.cubie = cell;
+    result.distance = t;
+    result.point = ray.origin + t * ray.direction;
+    if (axis < 0)
+    {
+        result.face = -1;
+        result.normalAxis = -1;
+        result.normalSign = 0;
+        return true;
+    }
+    // The ray crossed into the cell against its step, that side faces back at the ray
+    result.normalAxis = axis;
+    result.normalSign = -step[axis];
+    result.face = FaceFromNormal(axis, result.normalSign);
+    return true;
+}
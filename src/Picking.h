@@ -0,0 +1,30 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+struct Ray
+{
+    glm::vec3 origin;
+    glm::vec3 direction; // Not necessarily normalized
+};
+
+// What a ray hit on the cube. Grid space has one unit per cubie with the cube spanning
+// [0, size] on every axis, so cubie (x, y, z) is also the layer index on each axis.
+struct PickResult
+{
+    glm::ivec3 cubie;
+    int face;        // Sticker face order (see StickerState), -1 when the ray started inside the cubie
+    int normalAxis;  // Axis and sign of the hit face's normal
+    int normalSign;
+    float distance;  // Ray parameter of the hit, origin + distance * direction
+    glm::vec3 point; // Hit point in grid space
+};
+
+// Sticker face of the outward normal along axis with the given sign
+int FaceFromNormal(int axis, int sign);
+
+// Intersects a grid space ray with the bounding box of a size^3 cube and walks the cells it
+// crosses with a 3D DDA (Amanatides & Woo) until it reaches a cubie. No memory is touched
+// besides the arguments, a ray from outside stops in its first cell and one from inside the
+// cube crosses at most 3 * size cells.
+bool PickGrid(const Ray& ray, int size, PickResult& result);
@@ -0,0 +1,206 @@
+#include <Playback.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+Playback::Playback(Rubikscube* rubik, Animator* animator)
+    : m_Rubik(rubik), m_Animator(animator), m_Position(0), m_MovesPerSecond(2.0), m_Due(0.0), m_LastTime(0.0), m_Playing(false)
+{
+}
+
+bool Playback::ParseMoves(const std::string& text, int size, std::vector<WallMove>& moves)
+{
+    std::istringstream stream(text);
+    std::string token;
+    while (stream >> token)
+    {
+        size_t i = 0;
+        int depth = 1;
+        if (std::isdigit((unsigned char) token[i]))
+        {
+            depth = 0;
+            while (i < token.size() && std::isdigit((unsigned char) token[i]))
+            {
+                depth = depth * 10 + (token[i++] - '0');
+            }
+        }
+        if (i == token.size() || depth < 1 || depth > size)
+        {
+            std::cout << "Invalid move: " << token << std::endl;
+            return false;
+        }
+
+        // Clockwise as seen from the face is a negative turn around the axis pointing out of it
+        WallMove move;
+        int sign;
+        switch (token[i++])
+        {
+            case 'R': move.axis = 0; move.layer = size - depth; sign = -1; break;
+            case 'L': move.axis = 0; move.layer = depth - 1;    sign =  1; break;
+            case 'U': move.axis = 1; move.layer = size - depth; sign = -1; break;
+            case 'D': move.axis = 1; move.layer = depth - 1;    sign =  1; break;
+            case 'F': move.axis = 2; move.layer = size - depth; sign = -1; break;
+            case 'B': move.axis = 2; move.layer = depth - 1;    sign =  1; break;
+            default:
+                std::cout << "Invalid move: " << token << std::endl;
+                return false;
+        }
+        float degrees = 90.0f;
+        if (i < token.size() && token[i] == '2')
+        {
+            degrees = 180.0f;
+            i++;
+        }
+        if (i < token.size() && token[i] == '\'')
+        {
+            sign = -sign;
+            i++;
+        }
+        if (i != token.size())
+        {
+            std::cout << "Invalid move: " << token << std::endl;
+            return false;
+        }
+        move.degrees = sign * degrees;
+        move.duration = degrees / wallDegreesPerSecond;
+        moves.push_back(move);
+    }
+    return true;
+}
+
+bool Playback::LoadFile(const std::string& filepath)
+{
+    std::ifstream stream(filepath);
+    if (!stream)
+    {
+        std::cout << "Failed to open move file " << filepath << std::endl;
+        return false;
+    }
+    std::stringstream text;
+    text << stream.rdbuf();
+
+    std::vector<WallMove> moves;
+    if (!ParseMoves(text.str(), m_Rubik->getSize(), moves))
+    {
+        return false;
+    }
+    Load(moves);
+    std::cout << "Loaded " << moves.size() << " moves from " << filepath << std::endl;
+    return true;
+}
+
+void Playback::Load(const std::vector<WallMove>& moves)
+{
+    m_Animator->Flush();
+    m_Moves = moves;
+    m_Position = 0;
+    m_Due = 0.0;
+    m_Playing = false;
+}
+
+void Playback::Update(double now)
+{
+    if (!m_Playing)
+    {
+        return;
+    }
+    m_Due += std::min(now - m_LastTime, Animator::MaxFrameTime) * m_MovesPerSecond;
+    m_LastTime = now;
+
+    int count = std::min((int) m_Due, GetLength() - m_Position);
+    if (count <= 0)
+    {
+        return;
+    }
+    m_Due -= count;
+
+    // Everything but the newest move goes straight to the cube, the position only counts
+    // moves the cube accepted
+    m_Animator->Flush();
+    for (int i = 0; i < count - 1; i++)
+    {
+        if (!m_Rubik->ApplyWallMove(m_Moves[m_Position]))
+        {
+            StopAtLockedMove();
+            return;
+        }
+        m_Position++;
+    }
+    WallMove last = m_Moves[m_Position];
+    last.duration = std::min(last.duration, (float) (1.0 / m_MovesPerSecond));
+    if (!m_Animator->Start(last, now))
+    {
+        StopAtLockedMove();
+        return;
+    }
+    m_Position++;
+
+    if (m_Position == GetLength())
+    {
+        m_Playing = false;
+    }
+}
+
+void Playback::Play()
+{
+    if (m_Position == GetLength())
+    {
+        return;
+    }
+    m_Playing = true;
+    // The first move starts on the next update
+    m_Due = 1.0;
+    m_LastTime = glfwGetTime();
+}
+
+void Playback::Pause()
+{
+    m_Playing = false;
+}
+
+void Playback::Seek(int position)
+{
+    position = std::max(0, std::min(position, GetLength()));
+    m_Animator->Flush();
+    while (m_Position < position)
+    {
+        if (!m_Rubik->ApplyWallMove(m_Moves[m_Position]))
+        {
+            StopAtLockedMove();
+            break;
+        }
+        m_Position++;
+    }
+    while (m_Position > position)
+    {
+        WallMove inverse = m_Moves[m_Position - 1];
+        inverse.degrees = -inverse.degrees;
+        if (!m_Rubik->ApplyWallMove(inverse))
+        {
+            StopAtLockedMove();
+            break;
+        }
+        m_Position--;
+    }
+    m_Due = 0.0;
+    m_Rubik->MarkDirty();
+}
+
+void Playback::StopAtLockedMove()
+{
+    // Nothing was applied, the cube and the position still agree. Turning the half turned
+    // wall back onto the grid unblocks playback.
+    m_Playing = false;
+    m_Due = 0.0;
+    m_Rubik->MarkDirty();
+    std::cout << "Playback stopped at move " << m_Position << ", a half turned wall locks another axis" << std::endl;
+}
+
+void Playback::SetRate(double movesPerSecond)
+{
+    m_MovesPerSecond = std::max(movesPerSecond, 0.1);
+}
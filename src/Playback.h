@@ -0,0 +1,49 @@
+#pragma once
+
+#include <WallMove.h>
+#include <Animator.h>
+#include "RubiksCube.h"
+
+#include <string>
+#include <vector>
+
+// Replays a recorded move sequence (a solve or a scramble) at a target rate in moves per
+// second. Moves that became due since the last frame are applied straight to the cube and
+// only the newest one is animated, so rates above the display rate skip frames instead of
+// falling behind. Any position of the sequence can be sought to directly.
+class Playback
+{
+    private:
+        Rubikscube* m_Rubik;
+        Animator* m_Animator;
+        std::vector<WallMove> m_Moves;
+        int m_Position;        // Moves applied or started so far, rejected moves are not counted
+        double m_MovesPerSecond;
+        double m_Due;          // Moves owed to the schedule, fractional
+        double m_LastTime;
+        bool m_Playing;
+
+        // Called when the cube rejects the move at m_Position
+        void StopAtLockedMove();
+
+    public:
+        Playback(Rubikscube* rubik, Animator* animator);
+
+        // Parses moves in face notation: U D L R F B, an optional ' (counter clockwise) or 2
+        // (half turn) and an optional layer depth prefix for big cubes, e.g. "R U' 2F2 3L"
+        static bool ParseMoves(const std::string& text, int size, std::vector<WallMove>& moves);
+        bool LoadFile(const std::string& filepath);
+        void Load(const std::vector<WallMove>& moves);
+
+        void Update(double now);
+        void Play();
+        void Pause();
+        // Stops early at a move the cube rejects while a half turned wall locks another axis
+        void Seek(int position);
+        void SetRate(double movesPerSecond);
+
+        inline bool IsPlaying() const { return m_Playing; }
+        inline int GetPosition() const { return m_Position; }
+        inline int GetLength() const { return (int) m_Moves.size(); }
+        inline double GetRate() const { return m_MovesPerSecond; }
+};
@@ -0,0 +1,37 @@
+#include <ProceduralCubeRenderer.h>
+
+ProceduralCubeRenderer::ProceduralCubeRenderer(Shader* shader, Texture* texture)
+    : m_Shader(shader), m_Texture(texture)
+{
+}
+
+void ProceduralCubeRenderer::Draw(const glm::mat4& mvp, const CubieBuffer& cubies, const LayerTurns& turns)
+{
+    if (cubies.GetCount() == 0)
+    {
+        return;
+    }
+
+    glm::vec4 color(1.0f);
+    m_Shader->Bind();
+    m_Shader->SetUniform4f("u_Color", color);
+    m_Shader->SetUniformMat4f("u_MVP", mvp);
+    m_Shader->SetUniform1i("u_Cubies", CubieTextureSlot);
+    turns.SetUniforms(m_Shader);
+    if (m_Texture)
+    {
+        m_Texture->Bind(0);
+        m_Shader->SetUniform1i("u_Texture", 0);
+    }
+    DrawInstances(cubies);
+}
+
+void ProceduralCubeRenderer::DrawInstances(const CubieBuffer& cubies)
+{
+    GLCall(glActiveTexture(GL_TEXTURE0 + CubieTextureSlot));
+    GLCall(glBindTexture(GL_TEXTURE_BUFFER, cubies.GetTextureID()));
+    GLCall(glActiveTexture(GL_TEXTURE0));
+
+    m_VA.Bind();
+    GLCall(glDrawArraysInstanced(GL_TRIANGLES, 0, VerticesPerCube, (GLsizei) cubies.GetCount()));
+}
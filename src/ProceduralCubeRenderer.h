@@ -0,0 +1,36 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include <Debugger.h>
+#include <CubieBuffer.h>
+#include <SceneBuffer.h>
+#include <Shader.h>
+#include <Texture.h>
+#include <VertexArray.h>
+
+// Draws every cubie without any vertex data: the vertex shader builds the cube corners, face
+// and texture coordinates from gl_VertexID and fetches the cubie's CubieInstance by
+// gl_InstanceID from the texture buffer of a CubieBuffer (GL 3.1), so the geometry path needs
+// no mesh at all. Uses the PULLED variant of cube.shader.
+class ProceduralCubeRenderer
+{
+    private:
+        VertexArray m_VA;          // Empty, core profiles still need one bound to draw
+        Shader* m_Shader;
+        Texture* m_Texture;
+
+    public:
+        // One cube is 6 faces of two triangles, drawn as GL_TRIANGLES without indices
+        static const int VerticesPerCube = 36;
+        // Texture unit of the cubie buffer, unit 0 is the sticker texture
+        static const int CubieTextureSlot = 1;
+
+        ProceduralCubeRenderer(Shader* shader, Texture* texture);
+
+        void Draw(const glm::mat4& mvp, const CubieBuffer& cubies, const LayerTurns& turns);
+
+        // Draw without the shader setup, for passes that bring their own shader and uniforms (IdPicker)
+        void DrawInstances(const CubieBuffer& cubies);
+};
@@ -0,0 +1,95 @@
+#include <RenderThread.h>
+
+RenderThread::RenderThread(GLFWwindow* window, Rubikscube* rubik, SceneBuffer* scenes)
+    : m_Window(window), m_Rubik(rubik), m_Scenes(scenes), m_Recorder(nullptr), m_Profiler(nullptr), m_Picker(nullptr), m_Scaler(nullptr)
+{
+}
+
+RenderThread::~RenderThread()
+{
+    Stop();
+}
+
+void RenderThread::Start()
+{
+    if (IsRunning())
+    {
+        return;
+    }
+    // A context can only be current on one thread at a time
+    glfwMakeContextCurrent(nullptr);
+    m_Thread = std::thread(&RenderThread::Run, this);
+}
+
+void RenderThread::Stop()
+{
+    if (!IsRunning())
+    {
+        return;
+    }
+    m_Scenes->Close();
+    m_Thread.join();
+    // GL objects are destroyed on this thread afterwards
+    glfwMakeContextCurrent(m_Window);
+}
+
+void RenderThread::Run()
+{
+    glfwMakeContextCurrent(m_Window);
+    while (SceneSnapshot* scene = m_Scenes->WaitForSnapshot())
+    {
+        DrawFrame(*scene);
+    }
+    glfwMakeContextCurrent(nullptr);
+}
+
+void RenderThread::DrawFrame(SceneSnapshot& scene)
+{
+    {
+        ProfileScope scope(m_Profiler, "submit");
+        if (m_Profiler)
+        {
+            m_Profiler->BeginGpu("gpu draw");
+        }
+        if (m_Scaler)
+        {
+            m_Scaler->Begin();
+        }
+        m_Rubik->Draw(scene);
+        if (m_Scaler)
+        {
+            m_Scaler->End();
+        }
+        if (m_Profiler)
+        {
+            m_Profiler->EndGpu();
+        }
+    }
+    if (m_Recorder)
+    {
+        // The back buffer is undefined once swapped
+        ProfileScope scope(m_Profiler, "capture");
+        m_Recorder->Capture();
+    }
+    if (m_Picker)
+    {
+        ProfileScope scope(m_Profiler, "pick");
+        m_Picker->Update(scene);
+    }
+    {
+        ProfileScope scope(m_Profiler, "swap");
+        glfwSwapBuffers(m_Window);
+    }
+    GLCheckFrame("frame");
+    if (m_Profiler)
+    {
+        m_Profiler->EndFrame();
+        // Time between presented frames, idle time included when nothing changes
+        std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        if (m_LastFrame != std::chrono::steady_clock::time_point())
+        {
+            m_Profiler->AddSample("frame", std::chrono::duration<double, std::milli>(now - m_LastFrame).count());
+        }
+        m_LastFrame = now;
+    }
+}
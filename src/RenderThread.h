@@ -0,0 +1,46 @@
+#pragma once
+
+#include <SceneBuffer.h>
+#include <FrameRecorder.h>
+#include <FrameProfiler.h>
+#include <IdPicker.h>
+#include <ResolutionScaler.h>
+#include "RubiksCube.h"
+
+#include <thread>
+
+// Owns the window's GL context on a thread of its own and draws every snapshot published
+// to the scene buffer. glfwSwapBuffers (and its vsync wait) only blocks this thread, input
+// and simulation keep running on the main thread.
+class RenderThread
+{
+    private:
+        GLFWwindow* m_Window;
+        Rubikscube* m_Rubik;
+        SceneBuffer* m_Scenes;
+        FrameRecorder* m_Recorder;
+        FrameProfiler* m_Profiler;
+        IdPicker* m_Picker;
+        ResolutionScaler* m_Scaler;
+        std::chrono::steady_clock::time_point m_LastFrame;
+        std::thread m_Thread;
+
+        void Run();
+
+    public:
+        RenderThread(GLFWwindow* window, Rubikscube* rubik, SceneBuffer* scenes);
+        ~RenderThread();
+
+        // Moves the context to the render thread, must be called from the thread that has it current
+        void Start();
+        // Draws nothing more and hands the context back to the calling thread
+        void Stop();
+        inline bool IsRunning() const { return m_Thread.joinable(); }
+
+        // Draws, records and presents one snapshot on the calling thread, which must have the context
+        void DrawFrame(SceneSnapshot& scene);
+        inline void SetRecorder(FrameRecorder* recorder) { m_Recorder = recorder; }
+        inline void SetProfiler(FrameProfiler* profiler) { m_Profiler = profiler; }
+        inline void SetPicker(IdPicker* picker) { m_Picker = picker; }
+        inline void SetScaler(ResolutionScaler* scaler) { m_Scaler = scaler; }
+};
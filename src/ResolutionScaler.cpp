@@ -0,0 +1,132 @@
+#include <ResolutionScaler.h>
+
+#include <algorithm>
+#include <cmath>
+
+ResolutionScaler::ResolutionScaler(int width, int height, float budget)
+    : m_Target(width, height), m_Width(width), m_Height(height), m_Budget(budget), m_Scale(1.0f),
+      m_Average(0.0f), m_HeadroomCount(0), m_Cooldown(0), m_Next(0), m_Offscreen(false),
+      m_Settle(false), m_LastReduced(false)
+{
+    m_Target.Unbind();
+    for (Timing& timing : m_Timings)
+    {
+        GLCall(glGenQueries(1, &timing.begin));
+        GLCall(glGenQueries(1, &timing.end));
+        timing.pending = false;
+        timing.counted = false;
+    }
+}
+
+ResolutionScaler::~ResolutionScaler()
+{
+    for (Timing& timing : m_Timings)
+    {
+        GLCall(glDeleteQueries(1, &timing.begin));
+        GLCall(glDeleteQueries(1, &timing.end));
+    }
+}
+
+void ResolutionScaler::Begin()
+{
+    Collect();
+
+    // A frame still in flight in this slot is dropped, its queries are reused
+    Timing& timing = m_Timings[m_Next];
+    timing.counted = !m_Settle.exchange(false);
+    float scale = timing.counted ? m_Scale.load() : 1.0f;
+    m_Offscreen = scale < 1.0f;
+    m_LastReduced = m_Offscreen;
+    if (m_Offscreen)
+    {
+        m_Target.Bind();
+        GLCall(glViewport(0, 0, std::max(1, (int) std::lround(m_Width * scale)), std::max(1, (int) std::lround(m_Height * scale))));
+    }
+    GLCall(glQueryCounter(timing.begin, GL_TIMESTAMP));
+}
+
+void ResolutionScaler::End()
+{
+    Timing& timing = m_Timings[m_Next];
+    if (m_Offscreen)
+    {
+        // Stretch the drawn corner over the window, the clear of the frame covered the rest of it
+        int viewport[4];
+        GLCall(glGetIntegerv(GL_VIEWPORT, viewport));
+        GLCall(glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0));
+        GLCall(glBlitFramebuffer(0, 0, viewport[2], viewport[3], 0, 0, m_Width, m_Height, GL_COLOR_BUFFER_BIT, GL_LINEAR));
+        m_Target.Unbind();
+        GLCall(glViewport(0, 0, m_Width, m_Height));
+    }
+    GLCall(glQueryCounter(timing.end, GL_TIMESTAMP));
+    timing.pending = true;
+    m_Next = (m_Next + 1) % Latency;
+}
+
+void ResolutionScaler::Collect()
+{
+    // Oldest first, stop at the first frame the GPU has not finished
+    for (int i = 0; i < Latency; i++)
+    {
+        Timing& timing = m_Timings[(m_Next + i) % Latency];
+        if (!timing.pending)
+        {
+            continue;
+        }
+        GLint available = 0;
+        GLCall(glGetQueryObjectiv(timing.end, GL_QUERY_RESULT_AVAILABLE, &available));
+        if (!available)
+        {
+            break;
+        }
+        GLuint64 begin, end;
+        GLCall(glGetQueryObjectui64v(timing.begin, GL_QUERY_RESULT, &begin));
+        GLCall(glGetQueryObjectui64v(timing.end, GL_QUERY_RESULT, &end));
+        timing.pending = false;
+        if (timing.counted && end > begin)
+        {
+            AddSample((float) ((end - begin) / 1.0e6));
+        }
+    }
+}
+
+void ResolutionScaler::AddSample(float milliseconds)
+{
+    if (m_Cooldown > 0)
+    {
+        m_Cooldown--;
+        return;
+    }
+    m_Average = m_Average > 0.0f ? m_Average * 0.8f + milliseconds * 0.2f : milliseconds;
+
+    // The cost of a frame goes with its pixel count, the square of the scale
+    float scale = m_Scale;
+    float next = scale;
+    if (m_Average > m_Budget)
+    {
+        m_HeadroomCount = 0;
+        next = std::max(MinScale, std::max(scale * 0.7f, scale * std::sqrt(0.9f * m_Budget / m_Average)));
+    }
+    else if (m_Average < Headroom * m_Budget && scale < 1.0f)
+    {
+        float grown = std::min(1.0f, scale + ScaleStep);
+        float ratio = grown / scale;
+        // Only grow into a size that is expected to stay within budget
+        if (++m_HeadroomCount >= HeadroomFrames && m_Average * ratio * ratio < 0.9f * m_Budget)
+        {
+            next = grown;
+        }
+    }
+    else
+    {
+        m_HeadroomCount = 0;
+    }
+
+    if (next != scale)
+    {
+        m_Average *= (next / scale) * (next / scale);
+        m_Scale = next;
+        m_HeadroomCount = 0;
+        m_Cooldown = Latency;
+    }
+}
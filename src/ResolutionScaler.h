@@ -0,0 +1,61 @@
+#pragma once
+
+#include <Debugger.h>
+#include <Framebuffer.h>
+
+#include <atomic>
+
+// Dynamic resolution: while the GPU time of a frame is over budget the scene is drawn into a
+// smaller corner of an offscreen target and stretched to the window with a linear blit, and
+// the scale grows back once there is headroom again. Frames are timed with GL_TIMESTAMP queries
+// read back Latency frames later (they do not collide with the GL_TIME_ELAPSED queries of
+// FrameProfiler). Only fill cost shrinks with the scale, CPU bound frames are not helped.
+class ResolutionScaler
+{
+    public:
+        static const int Latency = 3;
+        static constexpr float MinScale = 0.25f;
+        static constexpr float ScaleStep = 0.1f;
+        // Frames in a row under the headroom fraction of the budget before the scale grows
+        static const int HeadroomFrames = 30;
+        static constexpr float Headroom = 0.6f;
+
+    private:
+        struct Timing
+        {
+            unsigned int begin, end;
+            bool pending;
+            bool counted;  // Settled frames are drawn at full size and not fed to the controller
+        };
+
+        Framebuffer m_Target;
+        int m_Width, m_Height;
+        float m_Budget;             // Milliseconds of GPU time per frame
+        std::atomic<float> m_Scale;
+        float m_Average;            // Smoothed GPU milliseconds at the current scale, 0 before the first sample
+        int m_HeadroomCount;
+        int m_Cooldown;             // Samples to skip after a change, they were measured at the old scale
+        Timing m_Timings[Latency];
+        int m_Next;
+        bool m_Offscreen;           // The frame being drawn goes through m_Target
+        std::atomic<bool> m_Settle;
+        std::atomic<bool> m_LastReduced;
+
+        void Collect();
+        void AddSample(float milliseconds);
+
+    public:
+        // width and height of the window's framebuffer, budget in milliseconds of GPU time
+        ResolutionScaler(int width, int height, float budget);
+        ~ResolutionScaler();
+
+        // Around drawing the scene, on the GL thread
+        void Begin();
+        void End();
+
+        inline float GetScale() const { return m_Scale; }
+        // The newest frame on screen was drawn below full resolution
+        inline bool NeedsSettle() const { return m_LastReduced; }
+        // Draws the next frame at full resolution, for a still image once motion stops
+        inline void Settle() { m_Settle = true; }
+};
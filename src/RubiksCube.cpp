@@ -1,22 +1,45 @@
 #include "RubiksCube.h"
 
-Rubikscube::Rubikscube(int size, Shader* shader, Texture* texture, VertexArray* va)
-    : m_Size(size), m_ModelMatrix(glm::mat4(1.0f)), m_CubeMatrix(size, std::vector<std::vector<Cube*>>(size, std::vector<Cube*>(size, nullptr))), clock(false), centerRotation(std::vector<int>(3,1)), locker(std::vector<int>(m_Size,0)), axisLocker('\0'){
+#include <algorithm>
+#include <cmath>
+
+// Palette index of faces without a sticker, see include/palette.glsl
+static const unsigned int blackColor = 6;
+
+Rubikscube::Rubikscube(int size, StickerRenderer* stickerRenderer)
+    : m_Size(size), m_ModelMatrix(glm::mat4(1.0f)), m_CubeMatrix(stickerRenderer ? 0 : size, std::vector<std::vector<int>>(size, std::vector<int>(size, -1))), clock(false), centerRotation(std::vector<int>(3,1)), locker(std::vector<int>(m_Size,0)), axisLocker('\0'),
+      m_Stickers(size), m_StickerRenderer(stickerRenderer), m_LayerAngles(size, 0.0f),
+      m_Batch(nullptr), m_BatchMesh(), m_BatchShader(nullptr), m_BatchTexture(nullptr), m_ProceduralRenderer(nullptr), m_Dirty(true), m_Scene(size){
+    // Scale big cubes down so they stay inside the view
+    m_ModelMatrix = glm::scale(glm::mat4(1.0f), glm::vec3(std::min(1.0f, 4.0f / size)));
+    if(m_StickerRenderer){
+        // The stickers are all that is needed, no cubies are allocated
+        m_Stickers.ClearDirty();
+        m_StickerRenderer->Upload(m_Stickers);
+        return;
+    }
     float offset = 1.0f;  // Adjust to ensure cubes are spaced correctly
     float centerOffset = (size - 1) / 2.0f;
     for (int x = 0; x < size; ++x) {
         for (int y = 0; y < size; ++y) {
             for (int z = 0; z < size; ++z) {
                 if(x==0 || y==0 || z==0 || x==size-1 || y==size-1 || z==size-1){ // Skip center cubes
-                    Cube* cube = new Cube(shader, texture, va); // Dynamically allocate cube
                     // Calculate position relative to the center
                     glm::vec3 position = glm::vec3(
                         (x - centerOffset) * offset,
                         (y - centerOffset) * offset,
                         (z - centerOffset) * offset
                     );
-                    cube->SetPosition(position);
-                    m_CubeMatrix[x][y][z] = cube;
+                    // Faces on the outside of the solved cube carry their sticker color, the rest are black
+                    const bool outside[StickerState::FaceCount] = { z == size - 1, z == 0, x == 0, x == size - 1, y == size - 1, y == 0 };
+                    unsigned int packed[2] = { 0, 0 };
+                    for (int face = 0; face < StickerState::FaceCount; face++) {
+                        unsigned int color = outside[face] ? face : blackColor;
+                        packed[face / 4] |= color << (8 * (face % 4));
+                    }
+                    int cubie = m_Transforms.Add(0, position);
+                    m_Instances.push_back({ glm::mat4(1.0f), glm::uvec2(packed[0], packed[1]) });
+                    m_CubeMatrix[x][y][z] = cubie;
                 }
             }
         }
@@ -25,20 +48,123 @@ Rubikscube::Rubikscube(int size, Shader* shader, Texture* texture, VertexArray*
 
 // Rendering each cube and the back scene
 void Rubikscube::Render(const glm::mat4& viewProjectionMatrix, GLFWwindow* window) {
+    Snapshot(m_Scene, viewProjectionMatrix);
+    Draw(m_Scene);
+    /* Swap front and back buffers */
+    glfwSwapBuffers(window);
+}
+
+void Rubikscube::Snapshot(SceneSnapshot& scene, const glm::mat4& viewProjectionMatrix) {
+    m_Dirty = false;
+    scene.mvp = viewProjectionMatrix * m_ModelMatrix;  // Apply global transforms
+    if (m_StickerRenderer) {
+        // Only the changed stickers are copied, appended since the renderer clears them once uploaded
+        m_TakenStickers.clear();
+        m_Stickers.TakeDirty(m_TakenStickers);
+        StickerRenderer::CoalesceRects(m_TakenStickers);
+        m_Stickers.CopyRects(m_TakenStickers, scene.stickerData);
+        scene.dirtyStickers.insert(scene.dirtyStickers.end(), m_TakenStickers.begin(), m_TakenStickers.end());
+        scene.axis = GetLockedAxis();
+        scene.layerAngles = m_LayerAngles;
+        return;
+    }
+    // Only cubies that moved since the last snapshot are generated again and sent, appended
+    // since the renderer clears them once uploaded
+    const size_t firstChanged = scene.changedCubies.size();
+    m_Transforms.UpdateInstances(m_Instances, scene.changedCubies);
+    for (size_t i = firstChanged; i < scene.changedCubies.size(); ++i) {
+        scene.changedInstances.push_back(m_Instances[scene.changedCubies[i]]);
+    }
+    scene.cubieCount = (unsigned int) m_Instances.size();
+
+    // Turned walls go to the vertex shader as ranges of layers with the same angle
+    const int axis = GetLockedAxis();
+    scene.turns.Clear(axis, (m_Size - 1) / 2.0f);
+    int first = 0;
+    for (int layer = 1; layer <= m_Size; ++layer) {
+        if (layer < m_Size && m_LayerAngles[layer] == m_LayerAngles[first]) {
+            continue;
+        }
+        float radians = glm::radians(m_LayerAngles[first]);
+        if (radians != 0.0f) {
+            scene.turns.Add(first, layer - 1, radians);
+        }
+        first = layer;
+    }
+}
+
+void Rubikscube::Draw(SceneSnapshot& scene) {
     GLCall(glClearColor(1.0f, 1.0f, 1.0f, 1.0f));
     GLCall(glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT));
-    for (int x = 0; x < m_Size; ++x) {
-        for (int y = 0; y < m_Size; ++y) {
-            for (int z = 0; z < m_Size; ++z) {
-                if (m_CubeMatrix[x][y][z] != nullptr) {
-                    glm::mat4 mvp = viewProjectionMatrix * m_ModelMatrix;  // Apply global transforms
-                    m_CubeMatrix[x][y][z]->Render(mvp, glm::vec4(1.0f));  // Default color
-                }
-            }
+    if (m_StickerRenderer) {
+        RenderStickers(scene);
+        return;
+    }
+    m_DrawnCubies.Apply(scene);
+    if (m_ProceduralRenderer) {
+        m_ProceduralRenderer->Draw(scene.mvp, m_DrawnCubies, scene.turns);
+        return;
+    }
+    if (m_Batch) {
+        RenderBatch(scene);
+    }
+}
+
+// Draws every cubie with a single instanced draw, the instance data is the cubie matrices and
+// face colors that stay in the CubieBuffer
+void Rubikscube::RenderBatch(const SceneSnapshot& scene) {
+    glm::vec4 color(1.0f);
+    m_BatchShader->Bind();
+    m_BatchShader->SetUniform4f("u_Color", color);
+    m_BatchShader->SetUniformMat4f("u_MVP", scene.mvp);
+    scene.turns.SetUniforms(m_BatchShader);
+    if (m_BatchTexture) {
+        m_BatchTexture->Bind(0);
+        m_BatchShader->SetUniform1i("u_Texture", 0);
+    }
+
+    m_Batch->Draw(m_BatchMesh, m_DrawnCubies.GetBuffer(), m_DrawnCubies.GetCount());
+    m_Batch->Submit();
+}
+
+void Rubikscube::SetBatch(MeshBatch* batch, const MeshHandle& mesh, Shader* shader, Texture* texture) {
+    m_Batch = batch;
+    m_BatchMesh = mesh;
+    m_BatchShader = shader;
+    m_BatchTexture = texture;
+}
+
+void Rubikscube::SetProceduralRenderer(ProceduralCubeRenderer* renderer) {
+    m_ProceduralRenderer = renderer;
+}
+
+// Draws the resting layers as one box each run and every turned layer as its own box
+void Rubikscube::RenderStickers(SceneSnapshot& scene) {
+    m_StickerRenderer->Upload(scene.dirtyStickers, scene.stickerData);
+    scene.dirtyStickers.clear();
+    scene.stickerData.clear();
+
+    int start = 0;
+    for (int layer = 0; layer <= m_Size; ++layer) {
+        if (layer < m_Size && scene.layerAngles[layer] == 0.0f) {
+            continue;
+        }
+        if (start < layer) {
+            m_StickerRenderer->DrawBox(scene.mvp, scene.axis, start, layer, 0.0f);
         }
+        if (layer < m_Size) {
+            m_StickerRenderer->DrawBox(scene.mvp, scene.axis, layer, layer + 1, scene.layerAngles[layer]);
+        }
+        start = layer + 1;
+    }
+}
+
+int Rubikscube::GetLockedAxis() const {
+    switch (axisLocker) {
+        case 'y': return 1;
+        case 'z': return 2;
+        default: return 0;
     }
-    /* Swap front and back buffers */
-    glfwSwapBuffers(window);
 }
 
 // Rotates the whole rubiks cube 
@@ -47,111 +173,144 @@ void Rubikscube::Rotate(const float Xangle, const float Yangle){
     globalRotation = glm::rotate(globalRotation, glm::radians(-Xangle), glm::vec3(0.0f, 1.0f, 0.0f));
     globalRotation = glm::rotate(globalRotation, glm::radians(-Yangle), glm::vec3(1.0f, 0.0f, 0.0f));
     m_ModelMatrix = globalRotation * m_ModelMatrix;
+    m_Dirty = true;
+}
+
+Ray Rubikscube::ToGridSpace(const Ray& ray) const {
+    // Cubies sit one unit apart around the origin, the grid starts at the corner of the cube
+    glm::mat4 toGrid = glm::translate(glm::mat4(1.0f), glm::vec3(m_Size / 2.0f)) * glm::inverse(m_ModelMatrix);
+    return { glm::vec3(toGrid * glm::vec4(ray.origin, 1.0f)), glm::vec3(toGrid * glm::vec4(ray.direction, 0.0f)) };
+}
+
+bool Rubikscube::Pick(const Ray& ray, PickResult& result) const {
+    return PickGrid(ToGridSpace(ray), m_Size, result);
 }
 
 Rubikscube::~Rubikscube() {
-    for (int x = 0; x < m_Size; ++x) {
-        for (int y = 0; y < m_Size; ++y) {
-            for (int z = 0; z < m_Size; ++z) {
-                if (m_CubeMatrix[x][y][z] != nullptr) {
-                    delete m_CubeMatrix[x][y][z];
-                    m_CubeMatrix[x][y][z] = nullptr; // Optional: set to nullptr after deletion
-                }
-            }
-        }
+}
+
+// Converts a wall given relative to the center of rotation into a move of steps * 45 degrees
+// in the current rotation direction
+WallMove Rubikscube::MakeWallMove(int layerIndex, const glm::vec3& axis, int steps, float degreesPerSecond) {
+    int axisIndex;
+    if(axis.x == 1.0f){
+        axisIndex = 0;
+    } else if(axis.y == 1.0f){
+        axisIndex = 1;
+    } else if(axis.z == 1.0f){
+        axisIndex = 2;
+    } else{
+        throw std::invalid_argument("Not an axis vector"); 
     }
+    layerIndex+=centerRotation[axisIndex];
+
+    // Consider limitations of layer index
+    if(layerIndex==-1){
+        layerIndex=0;
+    } else if(layerIndex==m_Size){
+        layerIndex=m_Size-1;
+    }
+
+    float degrees = 45.0f * steps * (clock ? 1.0f : -1.0f);
+    return { axisIndex, layerIndex, degrees, std::abs(degrees) / degreesPerSecond };
 }
 
-// Rotates a specific wall dependent on layer index, axis
-void Rubikscube::RotateWall45(int layerIndex, glm::vec3& axis, const glm::mat4& viewProjectionMatrix, GLFWwindow* window, float sensitivity) {
-    float angle = 45.0f;
-    float dtheta = sensitivity;
+// Starts turning a wall, returns false when another axis is locked by a half turned wall
+bool Rubikscube::BeginWallRotation(const WallMove& move) {
     // Checking if all walls in past rotations are back to didnt stop at 45 degrees
     bool allZero = true;
-    for(int i=0; i<locker.size(); i++){
+    for(int i=0; i<(int)locker.size(); i++){
         if(locker[i]!=0){
             allZero=false;
         }
     }
     // if true reset the axis to be none 
     // else check if the axis is not locked
+    const char axisNames[] = { 'x', 'y', 'z' };
     if(allZero){
         axisLocker='\0';
-    } else if((axis.x==1.0f && axisLocker!='x') || (axis.y==1.0f && axisLocker!='y')||(axis.z==1.0f && axisLocker!='z')){
+    } else if(axisLocker!=axisNames[move.axis]){
         std::cout << "dont change!" << std::endl;
-        return;
-    }
-    // Lock the axis and update the layer index dependent on the center of rotation
-    if(axis.x == 1.0f){
-        layerIndex+=centerRotation[0];
-        if(axisLocker=='x' || axisLocker=='\0'){
-            axisLocker='x';
-        }
-    } else if(axis.y == 1.0f){
-        layerIndex+=centerRotation[1];
-        if(axisLocker=='y' || axisLocker=='\0'){
-            axisLocker='y';
-        }
-    } else if(axis.z == 1.0f){
-        layerIndex+=centerRotation[2];
-        if(axisLocker=='z' || axisLocker=='\0'){
-            axisLocker='z';
-        }
-    } else{
-        throw std::invalid_argument("Not an axis vector"); 
+        return false;
     }
+    axisLocker=axisNames[move.axis];
+    return true;
+}
 
-    // Consider limitations of layer index
-    if(layerIndex==-1){
-        layerIndex=0;
-    } else if(layerIndex==m_Size){
-        layerIndex=m_Size-1;
-    }
+// Sets the wall to angle degrees away from where the move started, the cubies stay at
+// rest and are turned when drawn (LayerTurns)
+void Rubikscube::SetWallAngle(const WallMove& move, float angle) {
+    m_LayerAngles[move.layer] = 45.0f * locker[move.layer] + angle;
+    m_Dirty = true;
+}
 
+// Finishes a move: the wall is put at its final angle and every full 90 degrees
+// turn is applied to the cubie indices and the stickers
+void Rubikscube::EndWallRotation(const WallMove& move) {
     // Rotate indecies only after a full 90 degrees rotation
-    int pastRot = locker[layerIndex];
-    if(clock){
-        locker[layerIndex] = (pastRot+1)%2;
-        if(pastRot==1){
-            indexCounterClockWise(layerIndex, axis);
+    int eighths = locker[move.layer] + (int) std::lround(move.degrees / 45.0f);
+    int quarterTurns = eighths / 2;
+    locker[move.layer] = eighths % 2;
+    m_LayerAngles[move.layer] = 45.0f * locker[move.layer];
+
+    m_Dirty = true;
+    if(quarterTurns == 0){
+        return;
+    }
+
+    m_Stickers.ApplyTurn(move.axis, move.layer, quarterTurns);
+    if(!m_StickerRenderer){
+        m_Stickers.ClearDirty(); // Cubies carry their own colors
+        glm::vec3 axis(0.0f);
+        axis[move.axis] = 1.0f;
+        // Whole quarter turns go into the rest transforms by table lookup, a wall left half
+        // turned keeps its 45 degrees in m_LayerAngles
+        for (const std::vector<int>& row : CopyLayer(move.layer, axis)) {
+            for (int cubie : row) {
+                if (cubie >= 0) {
+                    m_Transforms.QuarterTurn(cubie, move.axis, quarterTurns);
+                }
+            }
         }
-    } else{
-        locker[layerIndex] = (pastRot-1)%2;
-        if(pastRot==-1){
-            indexClockWise(layerIndex, axis);
+        for(int i=0; i<std::abs(quarterTurns); i++){
+            if(quarterTurns > 0){
+                indexCounterClockWise(move.layer, axis);
+            } else{
+                indexClockWise(move.layer, axis);
+            }
         }
-        dtheta= -1*dtheta;
     }
+}
 
-    // Animate the rotation by seperating it to small rotations
-    while(angle>0.0f){
-        for (int y = 0; y < m_Size; ++y) {
-            for (int z = 0; z < m_Size; ++z) {
-                Cube* cube = nullptr;
-                if(axis.x == 1.0f){
-                    cube = m_CubeMatrix[layerIndex][y][z];
-                } else if(axis.y == 1.0f){
-                    cube = m_CubeMatrix[y][layerIndex][z];
-                } else if(axis.z == 1.0f){
-                    cube = m_CubeMatrix[y][z][layerIndex];
-                } else{
-                    throw std::invalid_argument("Not an axis vector"); 
-                }
-                if (cube) {
-                    glm::mat4 modelMatrix = cube->GetModelMatrix();
-                    glm::mat4 rotation = glm::rotate(glm::mat4(1.0f), glm::radians(dtheta), axis);
-                    cube->SetModelMatrix(rotation * modelMatrix);
-                }
+// Turns a wall straight to the end of the move without animating it
+bool Rubikscube::ApplyWallMove(const WallMove& move) {
+    if(!BeginWallRotation(move)){
+        return false;
+    }
+    EndWallRotation(move);
+    return true;
+}
+
+// Copies the cubies of one wall, indexed by the two remaining coordinates in order
+std::vector<std::vector<int>> Rubikscube::CopyLayer(int layerIndex, const glm::vec3& axis){
+    std::vector<std::vector<int>> slice(m_Size, std::vector<int>(m_Size, -1));
+    for(int i=0; i<m_Size; i++){
+        for(int j=0; j<m_Size; j++){
+            if(axis.x == 1.0f){
+                slice[i][j] = m_CubeMatrix[layerIndex][i][j];
+            } else if(axis.y == 1.0f){
+                slice[i][j] = m_CubeMatrix[i][layerIndex][j];
+            } else{
+                slice[i][j] = m_CubeMatrix[i][j][layerIndex];
             }
         }
-        angle-=sensitivity;
-        Render(viewProjectionMatrix, window);
     }
+    return slice;
 }
 
 // Changing cube index for a specific wall clock wise
 void Rubikscube::indexClockWise(int layerIndex, glm::vec3& axis){
-    std::vector<std::vector<std::vector<Cube*>>> temp = m_CubeMatrix;
+    std::vector<std::vector<int>> slice = CopyLayer(layerIndex, axis);
     bool loop;
     int i, j,limit;
     for(int radius=0; radius<(m_Size/2); radius++){
@@ -162,44 +321,44 @@ void Rubikscube::indexClockWise(int layerIndex, glm::vec3& axis){
         while(loop){
             if(j==radius && i != limit){
                 if(axis.x == 1.0f){
-                    m_CubeMatrix[layerIndex][i][j] = temp[layerIndex][limit-j+radius][i];
+                    m_CubeMatrix[layerIndex][i][j] = slice[limit-j+radius][i];
                 } else if(axis.y == 1.0f){
-                    m_CubeMatrix[i][layerIndex][j] = temp[j][layerIndex][limit-i+radius];
+                    m_CubeMatrix[i][layerIndex][j] = slice[j][limit-i+radius];
                 } else if(axis.z == 1.0f){
-                    m_CubeMatrix[i][j][layerIndex] = temp[limit-j+radius][i][layerIndex];
+                    m_CubeMatrix[i][j][layerIndex] = slice[limit-j+radius][i];
                 } else{
                     throw std::invalid_argument("Not an axis vector"); 
                 }
                 i++;
             } else if(i==limit && j != limit){
                 if(axis.x == 1.0f){
-                    m_CubeMatrix[layerIndex][i][j] = temp[layerIndex][limit-j+radius][i];
+                    m_CubeMatrix[layerIndex][i][j] = slice[limit-j+radius][i];
                 } else if(axis.y == 1.0f){
-                    m_CubeMatrix[i][layerIndex][j] = temp[j][layerIndex][limit-i+radius];
+                    m_CubeMatrix[i][layerIndex][j] = slice[j][limit-i+radius];
                 } else if(axis.z == 1.0f){
-                    m_CubeMatrix[i][j][layerIndex] = temp[limit-j+radius][i][layerIndex];
+                    m_CubeMatrix[i][j][layerIndex] = slice[limit-j+radius][i];
                 } else{
                     throw std::invalid_argument("Not an axis vector"); 
                 }
                 j++;
             } else if(j==limit && i != radius){
                 if(axis.x == 1.0f){
-                    m_CubeMatrix[layerIndex][i][j] = temp[layerIndex][limit-j+radius][i];
+                    m_CubeMatrix[layerIndex][i][j] = slice[limit-j+radius][i];
                 } else if(axis.y == 1.0f){
-                    m_CubeMatrix[i][layerIndex][j] = temp[j][layerIndex][limit-i+radius];
+                    m_CubeMatrix[i][layerIndex][j] = slice[j][limit-i+radius];
                 } else if(axis.z == 1.0f){
-                    m_CubeMatrix[i][j][layerIndex] = temp[limit-j+radius][i][layerIndex];
+                    m_CubeMatrix[i][j][layerIndex] = slice[limit-j+radius][i];
                 } else{
                     throw std::invalid_argument("Not an axis vector"); 
                 }
                 i--;
             } else if(i==radius){
                 if(axis.x == 1.0f){
-                    m_CubeMatrix[layerIndex][i][j] = temp[layerIndex][limit-j+radius][i];
+                    m_CubeMatrix[layerIndex][i][j] = slice[limit-j+radius][i];
                 } else if(axis.y == 1.0f){
-                    m_CubeMatrix[i][layerIndex][j] = temp[j][layerIndex][limit-i+radius];
+                    m_CubeMatrix[i][layerIndex][j] = slice[j][limit-i+radius];
                 } else if(axis.z == 1.0f){
-                    m_CubeMatrix[i][j][layerIndex] = temp[limit-j+radius][i][layerIndex];
+                    m_CubeMatrix[i][j][layerIndex] = slice[limit-j+radius][i];
                 } else{
                     throw std::invalid_argument("Not an axis vector"); 
                 }
@@ -214,7 +373,7 @@ void Rubikscube::indexClockWise(int layerIndex, glm::vec3& axis){
 
 // Changing cube index for a specific wall counter clock wise
 void Rubikscube::indexCounterClockWise(int layerIndex, glm::vec3& axis){
-    std::vector<std::vector<std::vector<Cube*>>> temp = m_CubeMatrix;
+    std::vector<std::vector<int>> slice = CopyLayer(layerIndex, axis);
     bool loop;
     int i, j,limit;
     for(int radius=0; radius<(m_Size/2); radius++){
@@ -225,44 +384,44 @@ void Rubikscube::indexCounterClockWise(int layerIndex, glm::vec3& axis){
         while(loop){
             if(j==radius && i != limit){
                 if(axis.x == 1.0f){
-                    m_CubeMatrix[layerIndex][limit-j+radius][i] = temp[layerIndex][i][j];
+                    m_CubeMatrix[layerIndex][limit-j+radius][i] = slice[i][j];
                 } else if(axis.y == 1.0f){
-                    m_CubeMatrix[j][layerIndex][limit-i+radius] = temp[i][layerIndex][j];
+                    m_CubeMatrix[j][layerIndex][limit-i+radius] = slice[i][j];
                 } else if(axis.z == 1.0f){
-                    m_CubeMatrix[limit-j+radius][i][layerIndex] = temp[i][j][layerIndex];
+                    m_CubeMatrix[limit-j+radius][i][layerIndex] = slice[i][j];
                 } else{
                     throw std::invalid_argument("Not an axis vector"); 
                 }
                 i++;
             } else if(i==limit && j != limit){
                 if(axis.x == 1.0f){
-                    m_CubeMatrix[layerIndex][limit-j+radius][i] = temp[layerIndex][i][j];
+                    m_CubeMatrix[layerIndex][limit-j+radius][i] = slice[i][j];
                 } else if(axis.y == 1.0f){
-                    m_CubeMatrix[j][layerIndex][limit-i+radius] = temp[i][layerIndex][j];
+                    m_CubeMatrix[j][layerIndex][limit-i+radius] = slice[i][j];
                 } else if(axis.z == 1.0f){
-                    m_CubeMatrix[limit-j+radius][i][layerIndex] = temp[i][j][layerIndex];
+                    m_CubeMatrix[limit-j+radius][i][layerIndex] = slice[i][j];
                 } else{
                     throw std::invalid_argument("Not an axis vector"); 
                 }
                 j++;
             } else if(j==limit && i != radius){
                 if(axis.x == 1.0f){
-                    m_CubeMatrix[layerIndex][limit-j+radius][i] = temp[layerIndex][i][j];
+                    m_CubeMatrix[layerIndex][limit-j+radius][i] = slice[i][j];
                 } else if(axis.y == 1.0f){
-                    m_CubeMatrix[j][layerIndex][limit-i+radius] = temp[i][layerIndex][j];
+                    m_CubeMatrix[j][layerIndex][limit-i+radius] = slice[i][j];
                 } else if(axis.z == 1.0f){
-                    m_CubeMatrix[limit-j+radius][i][layerIndex] = temp[i][j][layerIndex];
+                    m_CubeMatrix[limit-j+radius][i][layerIndex] = slice[i][j];
                 } else{
                     throw std::invalid_argument("Not an axis vector"); 
                 }
                 i--;
             } else if(i==radius){
                 if(axis.x == 1.0f){
-                    m_CubeMatrix[layerIndex][limit-j+radius][i] = temp[layerIndex][i][j];
+                    m_CubeMatrix[layerIndex][limit-j+radius][i] = slice[i][j];
                 } else if(axis.y == 1.0f){
-                    m_CubeMatrix[j][layerIndex][limit-i+radius] = temp[i][layerIndex][j];
+                    m_CubeMatrix[j][layerIndex][limit-i+radius] = slice[i][j];
                 } else if(axis.z == 1.0f){
-                    m_CubeMatrix[limit-j+radius][i][layerIndex] = temp[i][j][layerIndex];
+                    m_CubeMatrix[limit-j+radius][i][layerIndex] = slice[i][j];
                 } else{
                     throw std::invalid_argument("Not an axis vector"); 
                 }
@@ -308,4 +467,8 @@ void Rubikscube::setCenterRotation(glm::vec3& axis){
 
 int Rubikscube::getSize(){
     return m_Size;
+}
+
+const StickerState& Rubikscube::GetStickers() const{
+    return m_Stickers;
 }
\ No newline at end of file
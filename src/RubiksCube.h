@@ -2,7 +2,17 @@
 #define GLM_ENABLE_EXPERIMENTAL
 
 #include <vector>
-#include "Cube.h"
+#include <Shader.h>
+#include <Texture.h>
+#include <CubieTransforms.h>
+#include <CubieBuffer.h>
+#include <StickerState.h>
+#include <StickerRenderer.h>
+#include <MeshBatch.h>
+#include <ProceduralCubeRenderer.h>
+#include <SceneBuffer.h>
+#include <WallMove.h>
+#include <Picking.h>
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
@@ -15,24 +25,61 @@ class Rubikscube {
 private:
     int m_Size;                // Dimension of the Rubik's Cube (e.g., 3 for 3x3x3)
     glm::mat4 m_ModelMatrix;   // For global transformations
-    std::vector<std::vector<std::vector<Cube*>>> m_CubeMatrix; // 3D matrix of cube pointers
+    std::vector<std::vector<std::vector<int>>> m_CubeMatrix; // 3D matrix of cubie indices, -1 inside the cube
+    CubieTransforms m_Transforms;         // Rest transform of each cubie, turned walls are in m_LayerAngles
+    std::vector<CubieInstance> m_Instances; // Model matrix and face colors of each cubie, in cubie order
     bool clock;
     std::vector<int> centerRotation;
     std::vector<int> locker;
     char axisLocker;
+    StickerState m_Stickers;              // Facelet state, kept in sync with the cubies
+    StickerRenderer* m_StickerRenderer;   // Set when the cube is drawn from its stickers
+    std::vector<StickerRect> m_TakenStickers; // Changed rectangles of the snapshot being taken
+    std::vector<float> m_LayerAngles;     // Current angle of each layer along the locked axis
+    MeshBatch* m_Batch;                   // Set when all cubies are drawn as one instanced batch
+    MeshHandle m_BatchMesh;
+    Shader* m_BatchShader;
+    Texture* m_BatchTexture;
+    ProceduralCubeRenderer* m_ProceduralRenderer; // Set when the cubies are drawn without vertex data
+    bool m_Dirty;                         // Something changed since the last Render
+    SceneSnapshot m_Scene;                // Used when rendering on the simulation thread
+    CubieBuffer m_DrawnCubies;            // Render side copy of the cubies, patched from each drawn snapshot
 
+    void RenderStickers(SceneSnapshot& scene);
+    void RenderBatch(const SceneSnapshot& scene);
+    int GetLockedAxis() const;
 
 public:
-    Rubikscube(int size, Shader* shader, Texture* texture, VertexArray* va);
+    Rubikscube(int size, StickerRenderer* stickerRenderer = nullptr);
     void Render(const glm::mat4& viewProjectionMatrix, GLFWwindow* window);
+    // Copies what is needed to draw the current state, the snapshot can then be drawn on another thread
+    void Snapshot(SceneSnapshot& scene, const glm::mat4& viewProjectionMatrix);
+    // Issues the GL calls for a snapshot, touches no simulation state
+    void Draw(SceneSnapshot& scene);
     void RotateWall(const std::string& wall, float angle);
     void SetGlobalTransform(const glm::mat4& transform);
+    void SetBatch(MeshBatch* batch, const MeshHandle& mesh, Shader* shader, Texture* texture);
+    void SetProceduralRenderer(ProceduralCubeRenderer* renderer);
     void Rotate(const float Xangle, const float Yangle);
+    // World space ray to grid space, see PickResult
+    Ray ToGridSpace(const Ray& ray) const;
+    // Finds the cubie and face under a world space ray, turning layers are picked as if at rest
+    bool Pick(const Ray& ray, PickResult& result) const;
     ~Rubikscube(); 
-    void RotateWall45(int layerIndex, glm::vec3& axis, const glm::mat4& viewProjectionMatrix, GLFWwindow* window, float sensitivity);
+    WallMove MakeWallMove(int layerIndex, const glm::vec3& axis, int steps, float degreesPerSecond = wallDegreesPerSecond);
+    bool BeginWallRotation(const WallMove& move);
+    void SetWallAngle(const WallMove& move, float angle);
+    void EndWallRotation(const WallMove& move);
+    bool ApplyWallMove(const WallMove& move);
+    std::vector<std::vector<int>> CopyLayer(int layerIndex, const glm::vec3& axis);
     void indexClockWise(int layerIndex, glm::vec3& axis);
     void indexCounterClockWise(int layerIndex, glm::vec3& axis);
     void setClockWise();
     void setCenterRotation(glm::vec3& axis);
     int getSize();
+    inline void MarkDirty() { m_Dirty = true; }
+    inline bool IsDirty() const { return m_Dirty; }
+    const StickerState& GetStickers() const;
+    // The cubies as last drawn, only touched by the thread that draws
+    inline const CubieBuffer& GetDrawnCubies() const { return m_DrawnCubies; }
 };
@@ -0,0 +1,60 @@
+#include <SceneBuffer.h>
+
+#include <utility>
+
+SceneSnapshot::SceneSnapshot(int size)
+    : mvp(1.0f), cubieCount(0), axis(0), layerAngles(size, 0.0f)
+{
+}
+
+SceneBuffer::SceneBuffer(int size)
+    : m_Slots(3, SceneSnapshot(size)), m_Back(0), m_Ready(1), m_Front(2), m_Fresh(false), m_Closed(false)
+{
+}
+
+void SceneBuffer::Publish()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        if (m_Fresh)
+        {
+            // The renderer skipped the previous snapshot, its changes still need uploading
+            // and go first, the newer ones may overwrite them
+            SceneSnapshot& skipped = m_Slots[m_Ready];
+            SceneSnapshot& next = m_Slots[m_Back];
+            next.changedCubies.insert(next.changedCubies.begin(), skipped.changedCubies.begin(), skipped.changedCubies.end());
+            next.changedInstances.insert(next.changedInstances.begin(), skipped.changedInstances.begin(), skipped.changedInstances.end());
+            next.dirtyStickers.insert(next.dirtyStickers.begin(), skipped.dirtyStickers.begin(), skipped.dirtyStickers.end());
+            next.stickerData.insert(next.stickerData.begin(), skipped.stickerData.begin(), skipped.stickerData.end());
+            skipped.changedCubies.clear();
+            skipped.changedInstances.clear();
+            skipped.dirtyStickers.clear();
+            skipped.stickerData.clear();
+        }
+        std::swap(m_Back, m_Ready);
+        m_Fresh = true;
+    }
+    m_Published.notify_one();
+}
+
+SceneSnapshot* SceneBuffer::WaitForSnapshot()
+{
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    m_Published.wait(lock, [this] { return m_Fresh || m_Closed; });
+    if (m_Closed)
+    {
+        return nullptr;
+    }
+    std::swap(m_Front, m_Ready);
+    m_Fresh = false;
+    return &m_Slots[m_Front];
+}
+
+void SceneBuffer::Close()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Closed = true;
+    }
+    m_Published.notify_one();
+}
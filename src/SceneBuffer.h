@@ -0,0 +1,62 @@
+#pragma once
+
+#include <StickerState.h>
+#include <LayerTurns.h>
+#include <glm/glm.hpp>
+
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
+// Per instance data of one cubie, laid out like the instance attributes of the cubie batch
+struct CubieInstance
+{
+    glm::mat4 model;
+    glm::uvec2 faceColors; // Palette index of each face, one byte per face in sticker face order
+};
+
+// Everything needed to draw one frame of the cube, copied out of the simulation so the
+// renderer never reads state that input or animation may be changing
+struct SceneSnapshot
+{
+    glm::mat4 mvp;                        // View projection times the cube's global transform
+    unsigned int cubieCount;              // Cubie modes, cubies are drawn from a CubieBuffer
+    std::vector<int> changedCubies;       // Cubies the renderer has not uploaded yet
+    std::vector<CubieInstance> changedInstances; // Their rest transform and colors
+    LayerTurns turns;                     // Turned walls of the cubies
+    std::vector<StickerRect> dirtyStickers;   // Sticker mode: rectangles the renderer has not uploaded yet
+    std::vector<unsigned char> stickerData;   // Their stickers, see StickerState::CopyRects
+    int axis;                             // Locked axis of the layer angles
+    std::vector<float> layerAngles;
+
+    SceneSnapshot(int size);
+};
+
+// Triple buffered mailbox between the simulation thread (writer) and the render thread
+// (reader). The writer fills the back snapshot and publishes it, the reader takes the
+// newest published one. Neither side waits for the other to finish a frame, the lock
+// only guards swapping slot indices. Snapshots the reader never saw are dropped, but
+// their cubie and sticker changes are carried into the next one.
+class SceneBuffer
+{
+    private:
+        std::vector<SceneSnapshot> m_Slots;
+        int m_Back;   // Being written by the simulation
+        int m_Ready;  // Newest published snapshot
+        int m_Front;  // Being drawn by the renderer
+        bool m_Fresh; // m_Ready was published after the reader last took one
+        bool m_Closed;
+        std::mutex m_Mutex;
+        std::condition_variable m_Published;
+
+    public:
+        SceneBuffer(int size);
+
+        // Writer side
+        inline SceneSnapshot& GetBack() { return m_Slots[m_Back]; }
+        void Publish();
+
+        // Reader side: blocks until a new snapshot is published, nullptr once closed
+        SceneSnapshot* WaitForSnapshot();
+        void Close();
+};
@@ -1,49 +1,130 @@
 #include <Shader.h>
 
-Shader::Shader(const std::string& filepath)
-    : m_Filepath(filepath), m_RendererID(0)
+#include <GLExtensions.h>
+#include <ShaderCache.h>
+
+// Deeper than this an #include is assumed to include itself
+static const int maxIncludeDepth = 16;
+
+Shader::Shader(const std::string& filepath, const std::vector<std::string>& defines)
+    : m_Filepath(filepath), m_RendererID(0), m_VertexShader(0), m_FragmentShader(0)
 {
-    ShaderProgramSource source = ParseShader(filepath);
-    m_RendererID = CreateShader(source.VertexSource, source.FragmentSource);
+    ShaderProgramSource source;
+    if (!ParseShader(filepath, defines, source))
+    {
+        // Half a source would only fail to compile, or worse end up in the cache
+        std::cout << "Skipping shader " << filepath << std::endl;
+        return;
+    }
+
+    // Reuse the driver binary from an earlier run when the source and driver are unchanged
+    m_CacheKey = ShaderCache::MakeKey(source.VertexSource + source.FragmentSource);
+    m_RendererID = ShaderCache::Load(m_CacheKey);
+    if (m_RendererID == 0)
+    {
+        m_RendererID = CreateShader(source.VertexSource, source.FragmentSource);
+    }
 }
 
 Shader::~Shader()
 {
+    if (m_VertexShader)
+    {
+        GLCall(glDeleteShader(m_VertexShader));
+        GLCall(glDeleteShader(m_FragmentShader));
+    }
     GLCall(glDeleteProgram(m_RendererID));
 }
 
-ShaderProgramSource Shader::ParseShader(const std::string& filepath)
+bool Shader::ParseShader(const std::string& filepath, const std::vector<std::string>& defines, ShaderProgramSource& source)
+{
+    std::stringstream ss[2];
+    if (!ReadSource(filepath, ss, -1, 0))
+    {
+        return false;
+    }
+
+    std::string sources[2] = { ss[0].str(), ss[1].str() };
+    std::string defineLines;
+    for (const std::string& define : defines)
+    {
+        defineLines += "#define " + define + "\n";
+    }
+    if (!defineLines.empty())
+    {
+        for (std::string& stage : sources)
+        {
+            // #version has to stay the first directive
+            size_t insert = 0;
+            size_t version = stage.find("#version");
+            if (version != std::string::npos)
+            {
+                size_t end = stage.find('\n', version);
+                insert = end == std::string::npos ? stage.size() : end + 1;
+            }
+            stage.insert(insert, defineLines);
+        }
+    }
+
+    source = { sources[0], sources[1] };
+    return true;
+}
+
+bool Shader::ReadSource(const std::string& filepath, std::stringstream ss[2], int type, int depth)
 {
     std::ifstream stream(filepath);
+    if (!stream)
+    {
+        std::cout << "Failed to open shader " << filepath << std::endl;
+        return false;
+    }
+    if (depth > maxIncludeDepth)
+    {
+        std::cout << "Shader includes nested too deep in " << filepath << std::endl;
+        return false;
+    }
 
     enum class ShaderType
     {
         NONE = -1, VERTEX = 0, FRAGMENT = 1
     };
 
+    std::string directory = filepath.substr(0, filepath.find_last_of("/\\") + 1);
     std::string line;
-    std::stringstream ss[2];
-    ShaderType type = ShaderType::NONE;
     while (getline(stream, line))
     {
+        size_t include = line.find("#include");
         if (line.find("#shader") != std::string::npos)
         {
             if (line.find("vertex") != std::string::npos)
             {
-                type = ShaderType::VERTEX;
+                type = (int) ShaderType::VERTEX;
             }
             else if (line.find("fragment") != std::string::npos)
             {
-                type = ShaderType::FRAGMENT;
+                type = (int) ShaderType::FRAGMENT;
             }
         }
-        else 
+        else if (include != std::string::npos && line.find_first_not_of(" \t") == include)
         {
-            ss[(int)type] << line << '\n';
+            size_t open = line.find('"', include);
+            size_t close = open == std::string::npos ? open : line.find('"', open + 1);
+            if (close == std::string::npos)
+            {
+                std::cout << "Malformed #include in " << filepath << ": " << line << std::endl;
+                return false;
+            }
+            if (!ReadSource(directory + line.substr(open + 1, close - open - 1), ss, type, depth + 1))
+            {
+                return false;
+            }
+        }
+        else if (type != (int) ShaderType::NONE)
+        {
+            ss[type] << line << '\n';
         }
     }
-
-    return { ss[0].str(), ss[1].str() };
+    return true;
 }
 
 unsigned int Shader::CompileShader(unsigned int type, const std::string& source)
@@ -51,8 +132,14 @@ unsigned int Shader::CompileShader(unsigned int type, const std::string& source)
     GLCall(unsigned int id = glCreateShader(type));
     const char* src = source.c_str();
     GLCall(glShaderSource(id, 1, &src, nullptr));
+    // Only queued, the status is checked in Resolve
     GLCall(glCompileShader(id));
 
+    return id;
+}
+
+void Shader::CheckShader(unsigned int id, unsigned int type) const
+{
     int result;
     GLCall(glGetShaderiv(id, GL_COMPILE_STATUS, &result));
     if (result == GL_FALSE)
@@ -61,34 +148,67 @@ unsigned int Shader::CompileShader(unsigned int type, const std::string& source)
         GLCall(glGetShaderiv(id, GL_INFO_LOG_LENGTH, &length));
         char* message = (char*) alloca(length * sizeof(char));
         GLCall(glGetShaderInfoLog(id, length, &length, message));
-        std::cout << "Failed to compile " << (type == GL_VERTEX_SHADER ? "vertex" : "fragment") << " shader" << std::endl;
+        std::cout << "Failed to compile " << (type == GL_VERTEX_SHADER ? "vertex" : "fragment") << " shader " << m_Filepath << std::endl;
         std::cout << message << std::endl;
-        GLCall(glDeleteShader(id));
-        return 0;
     }
-
-    return id;
 }
 
 unsigned int Shader::CreateShader(const std::string& vertexShader, const std::string& fragmentShader)
 {
     GLCall(int program = glCreateProgram());
-    unsigned int vs = CompileShader(GL_VERTEX_SHADER, vertexShader);
-    unsigned int fs = CompileShader(GL_FRAGMENT_SHADER, fragmentShader);
+    m_VertexShader = CompileShader(GL_VERTEX_SHADER, vertexShader);
+    m_FragmentShader = CompileShader(GL_FRAGMENT_SHADER, fragmentShader);
 
-    GLCall(glAttachShader(program, vs));
-    GLCall(glAttachShader(program, fs));
+    GLCall(glAttachShader(program, m_VertexShader));
+    GLCall(glAttachShader(program, m_FragmentShader));
+    if (ShaderCache::IsEnabled())
+    {
+        // Some drivers only keep a binary around when asked before linking
+        GLCall(GLExtensions::ProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE));
+    }
     GLCall(glLinkProgram(program));
-    GLCall(glValidateProgram(program));
-
-    GLCall(glDeleteShader(vs));
-    GLCall(glDeleteShader(fs));
 
     return program;
 }
 
+void Shader::Resolve() const
+{
+    if (m_VertexShader == 0)
+    {
+        return;
+    }
+    int linked;
+    GLCall(glGetProgramiv(m_RendererID, GL_LINK_STATUS, &linked));
+    if (linked == GL_FALSE)
+    {
+        CheckShader(m_VertexShader, GL_VERTEX_SHADER);
+        CheckShader(m_FragmentShader, GL_FRAGMENT_SHADER);
+        int length;
+        GLCall(glGetProgramiv(m_RendererID, GL_INFO_LOG_LENGTH, &length));
+        if (length > 0)
+        {
+            char* message = (char*) alloca(length * sizeof(char));
+            GLCall(glGetProgramInfoLog(m_RendererID, length, &length, message));
+            std::cout << "Failed to link " << m_Filepath << std::endl;
+            std::cout << message << std::endl;
+        }
+    }
+    else
+    {
+        ShaderCache::Store(m_CacheKey, m_RendererID);
+    }
+
+    GLCall(glDetachShader(m_RendererID, m_VertexShader));
+    GLCall(glDetachShader(m_RendererID, m_FragmentShader));
+    GLCall(glDeleteShader(m_VertexShader));
+    GLCall(glDeleteShader(m_FragmentShader));
+    m_VertexShader = 0;
+    m_FragmentShader = 0;
+}
+
 void Shader::Bind() const
 {
+    Resolve();
     GLCall(glUseProgram(m_RendererID));
 }
 
@@ -99,22 +219,56 @@ void Shader::Unbind() const
 
 void Shader::SetUniform1i(const std::string& name, int value)
 {
-    GLCall(glUniform1i(GetUniformLocation(name), value));
+    int location = GetUniformLocation(name);
+    if (location != -1)
+    {
+        GLCall(glUniform1i(location, value));
+    }
 }
 
 void Shader::SetUniform1f(const std::string& name, float value)
 {
-    GLCall(glUniform1f(GetUniformLocation(name), value));
+    int location = GetUniformLocation(name);
+    if (location != -1)
+    {
+        GLCall(glUniform1f(location, value));
+    }
+}
+
+void Shader::SetUniform3f(const std::string& name, const glm::vec3& value)
+{
+    int location = GetUniformLocation(name);
+    if (location != -1)
+    {
+        GLCall(glUniform3f(location, value.x, value.y, value.z));
+    }
+}
+
+void Shader::SetUniform3fv(const std::string& name, const glm::vec3* values, int count)
+{
+    int location = GetUniformLocation(name);
+    if (location != -1)
+    {
+        GLCall(glUniform3fv(location, count, &values[0].x));
+    }
 }
 
 void Shader::SetUniform4f(const std::string& name, glm::vec4& value)
 {
-    GLCall(glUniform4f(GetUniformLocation(name), value.x, value.y, value.z, value.w));
+    int location = GetUniformLocation(name);
+    if (location != -1)
+    {
+        GLCall(glUniform4f(location, value.x, value.y, value.z, value.w));
+    }
 }
 
 void Shader::SetUniformMat4f(const std::string& name, const glm::mat4& matrix)
 {
-    GLCall(glUniformMatrix4fv(GetUniformLocation(name), 1, GL_FALSE, &matrix[0][0]));
+    int location = GetUniformLocation(name);
+    if (location != -1)
+    {
+        GLCall(glUniformMatrix4fv(location, 1, GL_FALSE, &matrix[0][0]));
+    }
 }
 
 int Shader::GetUniformLocation(const std::string& name)
@@ -124,6 +278,13 @@ int Shader::GetUniformLocation(const std::string& name)
         return m_UniformLocationCache[name];
     }
 
+    Resolve();
+    if (m_RendererID == 0)
+    {
+        // The shader was skipped, the setters ignore location -1
+        m_UniformLocationCache[name] = -1;
+        return -1;
+    }
     GLCall(int location = glGetUniformLocation(m_RendererID, name.c_str()));
     if (location == -1)
     {
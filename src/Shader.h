@@ -10,6 +10,7 @@
 #include <sstream>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 struct ShaderProgramSource
 {
@@ -17,14 +18,25 @@ struct ShaderProgramSource
     std::string FragmentSource;
 };
 
+// Shader files are split into stages with "#shader vertex" and "#shader fragment" and may pull in
+// other files with #include "path", relative to the including file. Variants of one file are made
+// with defines ("NAME" or "NAME VALUE") that are inserted after each stage's #version line.
+//
+// Compiling and linking are only started by the constructor, the link status is queried the first
+// time the program is used. Creating every shader before using any lets the driver work on them
+// at the same time (KHR_parallel_shader_compile) instead of waiting for each in turn.
 class Shader
 {
     private:
         std::string m_Filepath;
         unsigned int m_RendererID;
+        // Still attached until the link status has been checked
+        mutable unsigned int m_VertexShader;
+        mutable unsigned int m_FragmentShader;
+        std::string m_CacheKey;
         std::unordered_map<std::string, int> m_UniformLocationCache;
     public:
-        Shader(const std::string& filepath);
+        Shader(const std::string& filepath, const std::vector<std::string>& defines = {});
         ~Shader();
 
         void Bind() const;
@@ -33,12 +45,19 @@ class Shader
         // Set uniforms
         void SetUniform1i(const std::string& name, int value);
         void SetUniform1f(const std::string& name, float value);
+        void SetUniform3f(const std::string& name, const glm::vec3& value);
+        void SetUniform3fv(const std::string& name, const glm::vec3* values, int count);
         void SetUniform4f(const std::string& name, glm::vec4& value);
         void SetUniformMat4f(const std::string& name, const glm::mat4& matrix);
     private:
-        ShaderProgramSource ParseShader(const std::string& filepath);
+        // False when the file or one of its includes could not be read
+        bool ParseShader(const std::string& filepath, const std::vector<std::string>& defines, ShaderProgramSource& source);
+        bool ReadSource(const std::string& filepath, std::stringstream ss[2], int type, int depth);
         unsigned int CompileShader(unsigned int type, const std::string& source);
         unsigned int CreateShader(const std::string& vertexShader, const std::string& fragmentShader);
+        // Waits for the link started by the constructor and reports errors, once
+        void Resolve() const;
+        void CheckShader(unsigned int id, unsigned int type) const;
 
         int GetUniformLocation(const std::string& name);
 };
\ No newline at end of file
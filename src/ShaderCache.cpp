@@ -0,0 +1,176 @@
+#include <ShaderCache.h>
+
+#include <Debugger.h>
+#include <GLExtensions.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+static const char binaryMagic[4] = { 'R', 'S', 'B', '1' };
+
+struct ShaderBinaryHeader
+{
+    char magic[4];
+    uint32_t format;
+    uint32_t length;
+};
+
+std::string ShaderCache::s_Directory;
+
+// FNV-1a, the key only has to tell sources apart, not resist tampering
+static uint64_t Hash(uint64_t hash, const std::string& text)
+{
+    for (unsigned char c : text)
+    {
+        hash ^= c;
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+static std::string GetString(GLenum name)
+{
+    GLCall(const char* value = (const char*) glGetString(name));
+    return value ? value : "";
+}
+
+void ShaderCache::SetDirectory(const std::string& directory)
+{
+    s_Directory = directory;
+}
+
+bool ShaderCache::IsEnabled()
+{
+    if (s_Directory.empty() || !GLExtensions::ProgramBinary)
+    {
+        return false;
+    }
+    int formats = 0;
+    GLCall(glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats));
+    return formats > 0;
+}
+
+std::string ShaderCache::MakeKey(const std::string& source)
+{
+    uint64_t hash = 14695981039346656037ull;
+    hash = Hash(hash, GetString(GL_VENDOR));
+    hash = Hash(hash, GetString(GL_RENDERER));
+    hash = Hash(hash, GetString(GL_VERSION));
+    hash = Hash(hash, source);
+
+    char key[17];
+    std::snprintf(key, sizeof(key), "%016llx", (unsigned long long) hash);
+    return key;
+}
+
+std::string ShaderCache::GetPath(const std::string& key)
+{
+    return s_Directory + "/" + key + ".bin";
+}
+
+unsigned int ShaderCache::Load(const std::string& key)
+{
+    if (!IsEnabled())
+    {
+        return 0;
+    }
+    std::string path = GetPath(key);
+    std::ifstream file(path, std::ios::binary);
+    ShaderBinaryHeader header;
+    if (!file.read((char*) &header, sizeof(header)) || std::memcmp(header.magic, binaryMagic, sizeof(binaryMagic)) != 0)
+    {
+        return 0;
+    }
+    // Store writes the binary right after the header, any other length is a damaged entry
+    std::error_code error;
+    uintmax_t fileSize = std::filesystem::file_size(path, error);
+    if (error || header.length == 0 || fileSize != sizeof(header) + (uintmax_t) header.length)
+    {
+        return 0;
+    }
+    std::vector<char> binary(header.length);
+    if (!file.read(binary.data(), binary.size()))
+    {
+        return 0;
+    }
+
+    // glProgramBinary raises an error for a format the driver no longer offers
+    int formatCount = 0;
+    GLCall(glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount));
+    std::vector<int> formats(formatCount);
+    GLCall(glGetIntegerv(GL_PROGRAM_BINARY_FORMATS, formats.data()));
+    bool supported = false;
+    for (int format : formats)
+    {
+        supported = supported || (uint32_t) format == header.format;
+    }
+    if (!supported)
+    {
+        return 0;
+    }
+
+    GLCall(unsigned int program = glCreateProgram());
+    GLCall(GLExtensions::ProgramBinary(program, header.format, binary.data(), (GLsizei) binary.size()));
+
+    // A binary the driver rejects shows up as a failed link, the caller compiles instead
+    int linked = GL_FALSE;
+    GLCall(glGetProgramiv(program, GL_LINK_STATUS, &linked));
+    if (linked == GL_FALSE)
+    {
+        GLCall(glDeleteProgram(program));
+        return 0;
+    }
+    return program;
+}
+
+bool ShaderCache::Store(const std::string& key, unsigned int program)
+{
+    if (!IsEnabled())
+    {
+        return false;
+    }
+    int linked = GL_FALSE;
+    GLCall(glGetProgramiv(program, GL_LINK_STATUS, &linked));
+    int length = 0;
+    GLCall(glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length));
+    if (linked == GL_FALSE || length <= 0)
+    {
+        return false;
+    }
+    std::vector<char> binary(length);
+    GLenum format = 0;
+    GLCall(GLExtensions::GetProgramBinary(program, length, &length, &format, binary.data()));
+
+    std::error_code error;
+    std::filesystem::create_directories(s_Directory, error);
+
+    // Written under a temporary name first so a crash or a second instance never sees half a file
+    std::string path = GetPath(key);
+    std::string temporary = path + ".tmp";
+    {
+        std::ofstream file(temporary, std::ios::binary);
+        ShaderBinaryHeader header;
+        std::memcpy(header.magic, binaryMagic, sizeof(binaryMagic));
+        header.format = format;
+        header.length = (uint32_t) length;
+        file.write((const char*) &header, sizeof(header));
+        file.write(binary.data(), length);
+        if (!file)
+        {
+            std::cout << "Failed to write shader cache entry " << temporary << std::endl;
+            return false;
+        }
+    }
+    std::filesystem::rename(temporary, path, error);
+    if (error)
+    {
+        std::filesystem::remove(temporary, error);
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <string>
+
+// Keeps linked programs on disk as driver binaries (glGetProgramBinary) so later runs skip
+// compiling and linking. Entries are keyed by a hash of the shader source and the GL vendor,
+// renderer and version, a driver update or an edited shader simply misses the cache.
+class ShaderCache
+{
+    private:
+        static std::string s_Directory;
+
+        static std::string GetPath(const std::string& key);
+    public:
+        // Where the binaries are kept, an empty directory turns the cache off
+        static void SetDirectory(const std::string& directory);
+        // Needs a directory and GL 4.1 or ARB_get_program_binary with at least one binary format
+        static bool IsEnabled();
+
+        static std::string MakeKey(const std::string& source);
+
+        // Returns a linked program or 0 when there is no usable entry
+        static unsigned int Load(const std::string& key);
+        // The program has to be linked with GL_PROGRAM_BINARY_RETRIEVABLE_HINT set
+        static bool Store(const std::string& key, unsigned int program);
+};
@@ -0,0 +1,142 @@
+#include <StickerRenderer.h>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <algorithm>
+
+// Above this many rectangles on one face the face is sent as a single bounding rectangle
+static const int maxRectsPerFace = 32;
+
+StickerRenderer::StickerRenderer(Shader* shader, VertexArray* va, const IndexBuffer* ib)
+    : m_TextureID(0), m_Size(0), m_Shader(shader), m_VA(va), m_IB(ib)
+{
+    GLCall(glGenTextures(1, &m_TextureID));
+    GLCall(glBindTexture(GL_TEXTURE_2D_ARRAY, m_TextureID));
+
+    // Integer textures can only be sampled with nearest filtering
+    GLCall(glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_NEAREST));
+    GLCall(glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_NEAREST));
+    GLCall(glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE));
+    GLCall(glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE));
+
+    GLCall(glBindTexture(GL_TEXTURE_2D_ARRAY, 0));
+}
+
+StickerRenderer::~StickerRenderer()
+{
+    GLCall(glDeleteTextures(1, &m_TextureID));
+}
+
+void StickerRenderer::Upload(const StickerState& state)
+{
+    m_Size = state.GetSize();
+    GLCall(glBindTexture(GL_TEXTURE_2D_ARRAY, m_TextureID));
+    // Rows of one byte stickers are not 4 byte aligned for most sizes
+    GLCall(glPixelStorei(GL_UNPACK_ALIGNMENT, 1));
+    GLCall(glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_R8UI, m_Size, m_Size, StickerState::FaceCount, 0, GL_RED_INTEGER, GL_UNSIGNED_BYTE, state.GetData()));
+    GLCall(glPixelStorei(GL_UNPACK_ALIGNMENT, 4));
+    GLCall(glBindTexture(GL_TEXTURE_2D_ARRAY, 0));
+}
+
+void StickerRenderer::Upload(const std::vector<StickerRect>& dirty, const std::vector<unsigned char>& data)
+{
+    if (dirty.empty())
+    {
+        return;
+    }
+
+    GLCall(glBindTexture(GL_TEXTURE_2D_ARRAY, m_TextureID));
+    GLCall(glPixelStorei(GL_UNPACK_ALIGNMENT, 1));
+    const unsigned char* pixels = data.data();
+    for (const StickerRect& rect : dirty)
+    {
+        GLCall(glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, rect.u, rect.v, rect.face, rect.width, rect.height, 1, GL_RED_INTEGER, GL_UNSIGNED_BYTE, pixels));
+        pixels += rect.width * rect.height;
+    }
+    GLCall(glPixelStorei(GL_UNPACK_ALIGNMENT, 4));
+    GLCall(glBindTexture(GL_TEXTURE_2D_ARRAY, 0));
+}
+
+static StickerRect Union(const StickerRect& a, const StickerRect& b)
+{
+    int u = std::min(a.u, b.u);
+    int v = std::min(a.v, b.v);
+    int width = std::max(a.u + a.width, b.u + b.width) - u;
+    int height = std::max(a.v + a.height, b.v + b.height) - v;
+    return { a.face, u, v, width, height };
+}
+
+static long long Area(const StickerRect& rect)
+{
+    return (long long) rect.width * rect.height;
+}
+
+void StickerRenderer::CoalesceRects(std::vector<StickerRect>& rects)
+{
+    std::vector<StickerRect> merged;
+    for (int face = 0; face < StickerState::FaceCount; face++)
+    {
+        std::vector<StickerRect> faceRects;
+        for (const StickerRect& rect : rects)
+        {
+            if (rect.face == face)
+            {
+                faceRects.push_back(rect);
+            }
+        }
+        if ((int) faceRects.size() > maxRectsPerFace)
+        {
+            StickerRect bounds = faceRects[0];
+            for (const StickerRect& rect : faceRects)
+            {
+                bounds = Union(bounds, rect);
+            }
+            faceRects.assign(1, bounds);
+        }
+
+        bool changed = true;
+        while (changed)
+        {
+            changed = false;
+            for (size_t i = 0; i < faceRects.size() && !changed; i++)
+            {
+                for (size_t j = i + 1; j < faceRects.size(); j++)
+                {
+                    StickerRect both = Union(faceRects[i], faceRects[j]);
+                    if (Area(both) <= Area(faceRects[i]) + Area(faceRects[j]))
+                    {
+                        faceRects[i] = both;
+                        faceRects.erase(faceRects.begin() + j);
+                        changed = true;
+                        break;
+                    }
+                }
+            }
+        }
+        merged.insert(merged.end(), faceRects.begin(), faceRects.end());
+    }
+    rects.swap(merged);
+}
+
+void StickerRenderer::DrawBox(const glm::mat4& mvp, int axis, int from, int to, float angle)
+{
+    glm::vec3 boxMin(0.0f);
+    glm::vec3 boxMax((float) m_Size);
+    boxMin[axis] = (float) from;
+    boxMax[axis] = (float) to;
+
+    glm::vec3 rotationAxis(0.0f);
+    rotationAxis[axis] = 1.0f;
+    glm::mat4 rotation = glm::rotate(glm::mat4(1.0f), glm::radians(angle), rotationAxis);
+
+    GLCall(glActiveTexture(GL_TEXTURE0));
+    GLCall(glBindTexture(GL_TEXTURE_2D_ARRAY, m_TextureID));
+    m_Shader->Bind();
+    m_Shader->SetUniformMat4f("u_MVP", mvp * rotation);
+    m_Shader->SetUniform3f("u_BoxMin", boxMin);
+    m_Shader->SetUniform3f("u_BoxMax", boxMax);
+    m_Shader->SetUniform1f("u_Size", (float) m_Size);
+    m_Shader->SetUniform1i("u_Stickers", 0);
+    m_VA->Bind();
+    GLCall(glDrawElements(GL_TRIANGLES, m_IB->GetCount(), m_IB->GetType(), nullptr));
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include <Debugger.h>
+#include <Shader.h>
+#include <VertexArray.h>
+#include <IndexBuffer.h>
+#include <StickerState.h>
+
+#include <vector>
+
+// Draws the cube straight from a StickerState: the stickers live in a 2D texture array
+// (one NxN layer per face) and the cube is drawn as a few boxes using the shared cube mesh.
+// Sticker cells and borders are resolved in the fragment shader, so the number of draw
+// calls and vertices does not depend on the cube size.
+class StickerRenderer
+{
+    private:
+        unsigned int m_TextureID;
+        int m_Size;
+        Shader* m_Shader;
+        VertexArray* m_VA;
+        const IndexBuffer* m_IB;   // Bound to m_VA
+
+    public:
+        StickerRenderer(Shader* shader, VertexArray* va, const IndexBuffer* ib);
+        ~StickerRenderer();
+
+        // Uploads every sticker of the state (reallocates on size change)
+        void Upload(const StickerState& state);
+        // Uploads only the changed rectangles, so the cost follows the moves and not the cube size.
+        // data holds the stickers of each rectangle row by row, see StickerState::CopyRects
+        void Upload(const std::vector<StickerRect>& dirty, const std::vector<unsigned char>& data);
+
+        // Draws the layers [from, to) along axis as one box rotated by angle degrees
+        void DrawBox(const glm::mat4& mvp, int axis, int from, int to, float angle);
+
+        // Merges rectangles of the same face whenever their bounding rectangle is
+        // no bigger than the two together, leaving the fewest uploads
+        static void CoalesceRects(std::vector<StickerRect>& rects);
+};
@@ -0,0 +1,150 @@
+#include <StickerState.h>
+
+#include <algorithm>
+#include <stdexcept>
+
+StickerState::StickerState(int size)
+    : m_Size(size), m_Stickers(FaceCount * size * size)
+{
+    Reset();
+}
+
+void StickerState::Reset()
+{
+    for (int face = 0; face < FaceCount; face++)
+    {
+        std::fill(m_Stickers.begin() + Index(face, 0, 0), m_Stickers.begin() + Index(face, 0, 0) + m_Size * m_Size, (unsigned char) face);
+        m_Dirty.push_back({ face, 0, 0, m_Size, m_Size });
+    }
+}
+
+void StickerState::TakeDirty(std::vector<StickerRect>& dirty)
+{
+    dirty.insert(dirty.end(), m_Dirty.begin(), m_Dirty.end());
+    m_Dirty.clear();
+}
+
+void StickerState::CopyRects(const std::vector<StickerRect>& rects, std::vector<unsigned char>& data) const
+{
+    for (const StickerRect& rect : rects)
+    {
+        for (int v = rect.v; v < rect.v + rect.height; v++)
+        {
+            const unsigned char* row = &m_Stickers[Index(rect.face, rect.u, v)];
+            data.insert(data.end(), row, row + rect.width);
+        }
+    }
+}
+
+void StickerState::GetFaceAxes(int face, int& normalAxis, int& sign, int& uAxis, int& vAxis)
+{
+    switch (face)
+    {
+        case 0: normalAxis = 2; sign =  1; uAxis = 0; vAxis = 1; return; // Front
+        case 1: normalAxis = 2; sign = -1; uAxis = 0; vAxis = 1; return; // Back
+        case 2: normalAxis = 0; sign = -1; uAxis = 2; vAxis = 1; return; // Left
+        case 3: normalAxis = 0; sign =  1; uAxis = 2; vAxis = 1; return; // Right
+        case 4: normalAxis = 1; sign =  1; uAxis = 0; vAxis = 2; return; // Top
+        case 5: normalAxis = 1; sign = -1; uAxis = 0; vAxis = 2; return; // Bottom
+    }
+    throw std::invalid_argument("Not a face index");
+}
+
+static int FaceFromNormal(int normalAxis, int sign)
+{
+    switch (normalAxis)
+    {
+        case 0: return sign > 0 ? 3 : 2;
+        case 1: return sign > 0 ? 4 : 5;
+        default: return sign > 0 ? 0 : 1;
+    }
+}
+
+void StickerState::ApplyTurn(int axis, int layer, int quarterTurns)
+{
+    if (axis < 0 || axis > 2)
+    {
+        throw std::invalid_argument("Not an axis index");
+    }
+    if (layer < 0 || layer >= m_Size)
+    {
+        throw std::out_of_range("Layer index out of range");
+    }
+    quarterTurns = ((quarterTurns % 4) + 4) % 4;
+    for (int i = 0; i < quarterTurns; i++)
+    {
+        ApplyQuarterTurn(axis, layer);
+    }
+}
+
+// Rotates every sticker of the layer by +90 degrees. Stickers are moved through
+// their cubie coordinates (doubled and centered so the rotation stays integral).
+void StickerState::ApplyQuarterTurn(int axis, int layer)
+{
+    struct Moved { int face, u, v; unsigned char color; };
+    std::vector<Moved> moved;
+    moved.reserve(4 * m_Size + m_Size * m_Size);
+
+    // Collect the stickers that belong to the layer
+    for (int face = 0; face < FaceCount; face++)
+    {
+        int normalAxis, sign, uAxis, vAxis;
+        GetFaceAxes(face, normalAxis, sign, uAxis, vAxis);
+        if (normalAxis == axis)
+        {
+            if (layer != (sign > 0 ? m_Size - 1 : 0))
+            {
+                continue;
+            }
+            for (int v = 0; v < m_Size; v++)
+                for (int u = 0; u < m_Size; u++)
+                    moved.push_back({ face, u, v, Get(face, u, v) });
+            m_Dirty.push_back({ face, 0, 0, m_Size, m_Size });
+        }
+        else if (uAxis == axis)
+        {
+            for (int v = 0; v < m_Size; v++)
+                moved.push_back({ face, layer, v, Get(face, layer, v) });
+            m_Dirty.push_back({ face, layer, 0, 1, m_Size });
+        }
+        else
+        {
+            for (int u = 0; u < m_Size; u++)
+                moved.push_back({ face, u, layer, Get(face, u, layer) });
+            m_Dirty.push_back({ face, 0, layer, m_Size, 1 });
+        }
+    }
+
+    // Write every sticker to its rotated position
+    const int a = (axis + 1) % 3;
+    const int b = (axis + 2) % 3;
+    for (const Moved& sticker : moved)
+    {
+        int normalAxis, sign, uAxis, vAxis;
+        GetFaceAxes(sticker.face, normalAxis, sign, uAxis, vAxis);
+
+        int p[3], n[3] = { 0, 0, 0 };
+        p[normalAxis] = sign > 0 ? m_Size - 1 : 0;
+        p[uAxis] = sticker.u;
+        p[vAxis] = sticker.v;
+        n[normalAxis] = sign;
+        for (int i = 0; i < 3; i++)
+        {
+            p[i] = 2 * p[i] - (m_Size - 1);
+        }
+
+        // (a, b) -> (-b, a) is a +90 degrees rotation around the remaining axis
+        int pa = p[a], na = n[a];
+        p[a] = -p[b]; p[b] = pa;
+        n[a] = -n[b]; n[b] = na;
+
+        for (int i = 0; i < 3; i++)
+        {
+            p[i] = (p[i] + (m_Size - 1)) / 2;
+        }
+        int newAxis = n[0] != 0 ? 0 : (n[1] != 0 ? 1 : 2);
+        int newFace = FaceFromNormal(newAxis, n[newAxis]);
+        GetFaceAxes(newFace, normalAxis, sign, uAxis, vAxis);
+        m_Stickers[Index(newFace, p[uAxis], p[vAxis])] = sticker.color;
+    }
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <vector>
+
+// Rectangle of stickers on one face that changed since the dirty list was last taken
+struct StickerRect
+{
+    int face;
+    int u, v;
+    int width, height;
+};
+
+// Sticker (facelet) model of an NxNxN cube: six NxN grids of color indices.
+// Face order and colors match the per-face colors of the cubie mesh:
+// 0 Front (+z), 1 Back (-z), 2 Left (-x), 3 Right (+x), 4 Top (+y), 5 Bottom (-y).
+// A sticker at cell (u, v) of a face covers the cubie whose grid coordinates
+// along the face's u/v axes are u and v (see GetFaceAxes).
+class StickerState
+{
+    private:
+        int m_Size;
+        std::vector<unsigned char> m_Stickers; // [face][v][u]
+        std::vector<StickerRect> m_Dirty;
+
+    public:
+        static const int FaceCount = 6;
+
+        StickerState(int size);
+
+        // Turns one layer by quarterTurns * 90 degrees around axis (0 = x, 1 = y, 2 = z).
+        // Positive turns follow the right hand rule, like glm::rotate with a positive angle.
+        void ApplyTurn(int axis, int layer, int quarterTurns);
+        void Reset();
+
+        // Moves the rectangles changed by turns since the last call into dirty
+        void TakeDirty(std::vector<StickerRect>& dirty);
+        // Appends the stickers inside each rectangle to data, row by row in rectangle order
+        void CopyRects(const std::vector<StickerRect>& rects, std::vector<unsigned char>& data) const;
+        inline void ClearDirty() { m_Dirty.clear(); }
+
+        inline int GetSize() const { return m_Size; }
+        inline unsigned char Get(int face, int u, int v) const { return m_Stickers[Index(face, u, v)]; }
+        inline const unsigned char* GetFaceData(int face) const { return &m_Stickers[Index(face, 0, 0)]; }
+        inline const unsigned char* GetData() const { return m_Stickers.data(); }
+
+        // Axis of the face normal, its sign (+1/-1) and the grid axes used for u and v
+        static void GetFaceAxes(int face, int& normalAxis, int& sign, int& uAxis, int& vAxis);
+
+    private:
+        inline int Index(int face, int u, int v) const { return (face * m_Size + v) * m_Size + u; }
+        void ApplyQuarterTurn(int axis, int layer);
+};
@@ -1,16 +1,32 @@
-#include <stb/stb_image.h>
-#include <stb/stb_image_write.h>
-
 #include <Texture.h>
 
+#include <GLExtensions.h>
+
+#include <algorithm>
+
 Texture::Texture(const std::string& filepath)
-    : m_RendererID(0), m_Filepath(filepath), m_LocalBuffer(nullptr), m_Width(0), m_Height(0), m_Components(0)
+    : m_RendererID(0), m_Filepath(filepath), m_Width(0), m_Height(0)
 {
-    // Flips the image so it appears right side up
-    stbi_set_flip_vertically_on_load(1);
+    // Reads the image, or its baked mip levels, from a file
+    TextureData data;
+    data.Load(filepath);
+    Create(data);
+}
+
+Texture::Texture(const TextureData& data)
+    : m_RendererID(0), m_Filepath(data.GetFilepath()), m_Width(0), m_Height(0)
+{
+    Create(data);
+}
 
-    // Reads the image from a file and stores it in m_LocalBuffer
-    m_LocalBuffer = stbi_load(filepath.c_str(), &m_Width, &m_Height, &m_Components, 4);
+void Texture::Create(const TextureData& data)
+{
+    const std::vector<TextureLevel>& levels = data.GetLevels();
+    if (!levels.empty())
+    {
+        m_Width = levels[0].width;
+        m_Height = levels[0].height;
+    }
 
     // Generates an OpenGL texture object
     GLCall(glGenTextures(1, &m_RendererID));
@@ -26,20 +42,68 @@ Texture::Texture(const std::string& filepath)
     GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT));
 	GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT));
 
+    if (levels.empty())
+    {
+        GLCall(glBindTexture(GL_TEXTURE_2D, 0));
+        return;
+    }
+
+    // A decoded image only has its first level, the rest are generated below
+    bool generateMipmaps = levels.size() == 1 && !data.IsCompressed();
+    int levelCount = (int) levels.size();
+    if (generateMipmaps)
+    {
+        int size = std::max(m_Width, m_Height);
+        while (size > 1)
+        {
+            size /= 2;
+            levelCount++;
+        }
+    }
+
+    // Immutable storage lets the driver allocate every level once and skip completeness checks
+    if (GLExtensions::TexStorage2D)
+    {
+        GLCall(GLExtensions::TexStorage2D(GL_TEXTURE_2D, levelCount, data.GetFormat(), m_Width, m_Height));
+    }
+    else
+    {
+        GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, levelCount - 1));
+    }
+
     // Assigns the image to the OpenGL Texture object
-    GLCall(glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, m_Width, m_Height, 0, GL_RGBA, GL_UNSIGNED_BYTE, m_LocalBuffer));
+    for (int i = 0; i < (int) levels.size(); i++)
+    {
+        const TextureLevel& level = levels[i];
+        if (data.IsCompressed())
+        {
+            if (!GLExtensions::TexStorage2D)
+            {
+                GLCall(glCompressedTexImage2D(GL_TEXTURE_2D, i, data.GetFormat(), level.width, level.height, 0, (GLsizei) level.size, level.data));
+            }
+            else
+            {
+                GLCall(glCompressedTexSubImage2D(GL_TEXTURE_2D, i, 0, 0, level.width, level.height, data.GetFormat(), (GLsizei) level.size, level.data));
+            }
+        }
+        else if (!GLExtensions::TexStorage2D)
+        {
+            GLCall(glTexImage2D(GL_TEXTURE_2D, i, data.GetFormat(), level.width, level.height, 0, GL_RGBA, GL_UNSIGNED_BYTE, level.data));
+        }
+        else
+        {
+            GLCall(glTexSubImage2D(GL_TEXTURE_2D, i, 0, 0, level.width, level.height, GL_RGBA, GL_UNSIGNED_BYTE, level.data));
+        }
+    }
 
     // Generates Mipmaps
-	GLCall(glGenerateMipmap(GL_TEXTURE_2D));
+    if (generateMipmaps)
+    {
+        GLCall(glGenerateMipmap(GL_TEXTURE_2D));
+    }
 
     // Unbinds the OpenGL Texture object so that it can't accidentally be modified
     GLCall(glBindTexture(GL_TEXTURE_2D, 0));
-
-    if (m_LocalBuffer)
-    {
-        // Deletes the image data as it is already in the OpenGL Texture object
-        stbi_image_free(m_LocalBuffer);
-    }
 }
 
 Texture::~Texture()
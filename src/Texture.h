@@ -1,6 +1,7 @@
 #pragma once
 
 #include <Debugger.h>
+#include <TextureData.h>
 
 #include <iostream>
 #include <string>
@@ -10,10 +11,13 @@ class Texture
     private:
         unsigned int m_RendererID;
         std::string m_Filepath;
-        unsigned char* m_LocalBuffer;
-        int m_Width, m_Height, m_Components;
+        int m_Width, m_Height;
+
+        void Create(const TextureData& data);
     public:
         Texture(const std::string& filepath);
+        // Uploads pixels that were loaded ahead of time, see TextureData::LoadAsync
+        Texture(const TextureData& data);
         ~Texture();
 
         void Bind(unsigned int slot = 0) const;
@@ -21,4 +25,4 @@ class Texture
 
         inline int GetWidth() const { return m_Width; }
         inline int GetHeight() const { return m_Height; }
-};
\ No newline at end of file
+};
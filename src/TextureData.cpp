@@ -0,0 +1,285 @@
+#include <stb/stb_image.h>
+
+#include <TextureData.h>
+
+#include <glad/glad.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+// Layout of a .tex file: header, one TextureFileLevel per level, then the level data
+// with every level starting on a 16 byte boundary. All fields are little endian.
+static const char textureMagic[4] = { 'R', 'T', 'X', '1' };
+static const uint32_t textureVersion = 1;
+static const size_t levelAlignment = 16;
+// Larger sizes are rejected before any level size is computed from them
+static const uint32_t maxTextureSize = 1 << 16;
+
+struct TextureFileHeader
+{
+    char magic[4];
+    uint32_t version;
+    uint32_t format;
+    uint32_t compressed;
+    uint32_t width;
+    uint32_t height;
+    uint32_t levelCount;
+    uint32_t reserved;
+};
+
+struct TextureFileLevel
+{
+    uint32_t width;
+    uint32_t height;
+    uint64_t offset;
+    uint64_t size;
+};
+
+static std::string BakedPath(const std::string& filepath)
+{
+    size_t dot = filepath.find_last_of('.');
+    size_t slash = filepath.find_last_of("/\\");
+    if (dot == std::string::npos || (slash != std::string::npos && dot < slash))
+    {
+        return filepath + ".tex";
+    }
+    return filepath.substr(0, dot) + ".tex";
+}
+
+static bool IsBaked(const std::string& filepath)
+{
+    return filepath.size() >= 4 && filepath.compare(filepath.size() - 4, 4, ".tex") == 0;
+}
+
+TextureData::TextureData()
+    : m_Format(GL_RGBA8), m_Compressed(false)
+{
+}
+
+bool TextureData::Load(const std::string& filepath)
+{
+    m_Filepath = filepath;
+    m_Levels.clear();
+    m_Pixels.clear();
+    m_File.reset();
+
+    if (IsBaked(filepath))
+    {
+        return Map(filepath);
+    }
+    std::string baked = BakedPath(filepath);
+    if (Map(baked))
+    {
+        return true;
+    }
+    return Decode(filepath);
+}
+
+std::future<TextureData> TextureData::LoadAsync(const std::string& filepath)
+{
+    return std::async(std::launch::async, [filepath]()
+    {
+        TextureData data;
+        data.Load(filepath);
+        return data;
+    });
+}
+
+bool TextureData::Decode(const std::string& filepath)
+{
+    // Flips the image so it appears right side up, only for this thread
+    stbi_set_flip_vertically_on_load_thread(1);
+
+    int width, height, components;
+    unsigned char* pixels = stbi_load(filepath.c_str(), &width, &height, &components, 4);
+    if (!pixels)
+    {
+        std::cout << "Failed to load texture " << filepath << ": " << stbi_failure_reason() << std::endl;
+        return false;
+    }
+    size_t size = (size_t) width * height * 4;
+    m_Pixels.assign(pixels, pixels + size);
+    stbi_image_free(pixels);
+
+    m_Format = GL_RGBA8;
+    m_Compressed = false;
+    m_Levels.push_back({ width, height, m_Pixels.data(), size });
+    return true;
+}
+
+bool TextureData::Map(const std::string& filepath)
+{
+    std::unique_ptr<MappedFile> file(new MappedFile());
+    if (!file->Open(filepath))
+    {
+        return false;
+    }
+    const unsigned char* data = file->GetData();
+    size_t fileSize = file->GetSize();
+
+    TextureFileHeader header;
+    if (fileSize < sizeof(header))
+    {
+        std::cout << "Texture file " << filepath << " is truncated" << std::endl;
+        return false;
+    }
+    std::memcpy(&header, data, sizeof(header));
+    if (std::memcmp(header.magic, textureMagic, sizeof(textureMagic)) != 0 || header.version != textureVersion)
+    {
+        std::cout << "Texture file " << filepath << " has an unknown format" << std::endl;
+        return false;
+    }
+    size_t tableEnd = sizeof(header) + (size_t) header.levelCount * sizeof(TextureFileLevel);
+    if (header.levelCount == 0 || tableEnd > fileSize)
+    {
+        std::cout << "Texture file " << filepath << " is truncated" << std::endl;
+        return false;
+    }
+
+    if (header.compressed == 0 && header.format != GL_RGBA8)
+    {
+        std::cout << "Texture file " << filepath << " has an unknown format" << std::endl;
+        return false;
+    }
+    if (header.width == 0 || header.height == 0 || header.width > maxTextureSize || header.height > maxTextureSize)
+    {
+        std::cout << "Texture file " << filepath << " has a bad size" << std::endl;
+        return false;
+    }
+
+    std::vector<TextureLevel> levels;
+    uint32_t width = header.width;
+    uint32_t height = header.height;
+    for (uint32_t i = 0; i < header.levelCount; i++)
+    {
+        TextureFileLevel level;
+        std::memcpy(&level, data + sizeof(header) + i * sizeof(level), sizeof(level));
+        if (level.offset > fileSize || level.size > fileSize - level.offset)
+        {
+            std::cout << "Texture file " << filepath << " is truncated" << std::endl;
+            return false;
+        }
+        // Every level halves the one before, starting at the header's size and ending at 1x1
+        if (level.width != width || level.height != height || (i > 0 && levels.back().width == 1 && levels.back().height == 1))
+        {
+            std::cout << "Texture file " << filepath << " has a bad mip chain at level " << i << std::endl;
+            return false;
+        }
+        // Uncompressed levels are RGBA8, compressed sizes depend on the format and are left to GL
+        if (header.compressed == 0 && level.size != (uint64_t) width * height * 4)
+        {
+            std::cout << "Texture file " << filepath << " has a bad size at level " << i << std::endl;
+            return false;
+        }
+        width = std::max(1u, width / 2);
+        height = std::max(1u, height / 2);
+        levels.push_back({ (int) level.width, (int) level.height, data + level.offset, (size_t) level.size });
+    }
+
+    m_Format = header.format;
+    m_Compressed = header.compressed != 0;
+    m_Levels.swap(levels);
+    m_File = std::move(file);
+    return true;
+}
+
+void TextureData::GenerateMipmaps()
+{
+    if (m_Compressed || m_Levels.size() != 1)
+    {
+        return;
+    }
+    // Work out the whole chain first so the pixel buffer is only allocated once
+    std::vector<TextureLevel> levels = m_Levels;
+    size_t total = m_Levels[0].size;
+    while (levels.back().width > 1 || levels.back().height > 1)
+    {
+        int width = std::max(1, levels.back().width / 2);
+        int height = std::max(1, levels.back().height / 2);
+        size_t size = (size_t) width * height * 4;
+        levels.push_back({ width, height, nullptr, size });
+        total += size;
+    }
+
+    std::vector<unsigned char> pixels(total);
+    std::memcpy(pixels.data(), m_Levels[0].data, m_Levels[0].size);
+    levels[0].data = pixels.data();
+    size_t offset = m_Levels[0].size;
+    for (size_t i = 1; i < levels.size(); i++)
+    {
+        const TextureLevel& source = levels[i - 1];
+        TextureLevel& level = levels[i];
+        unsigned char* out = pixels.data() + offset;
+        level.data = out;
+        offset += level.size;
+
+        // Averages 2x2 blocks, the last row or column of an odd sized level is reused
+        for (int y = 0; y < level.height; y++)
+        {
+            int y0 = std::min(2 * y, source.height - 1);
+            int y1 = std::min(2 * y + 1, source.height - 1);
+            for (int x = 0; x < level.width; x++)
+            {
+                int x0 = std::min(2 * x, source.width - 1);
+                int x1 = std::min(2 * x + 1, source.width - 1);
+                for (int c = 0; c < 4; c++)
+                {
+                    int sum = source.data[(y0 * source.width + x0) * 4 + c]
+                            + source.data[(y0 * source.width + x1) * 4 + c]
+                            + source.data[(y1 * source.width + x0) * 4 + c]
+                            + source.data[(y1 * source.width + x1) * 4 + c];
+                    out[(y * level.width + x) * 4 + c] = (unsigned char) ((sum + 2) / 4);
+                }
+            }
+        }
+    }
+    m_Pixels.swap(pixels);
+    m_Levels.swap(levels);
+    m_File.reset();
+}
+
+bool TextureData::Bake(const std::string& filepath) const
+{
+    if (m_Levels.empty())
+    {
+        return false;
+    }
+    TextureFileHeader header = {};
+    std::memcpy(header.magic, textureMagic, sizeof(textureMagic));
+    header.version = textureVersion;
+    header.format = m_Format;
+    header.compressed = m_Compressed ? 1 : 0;
+    header.width = (uint32_t) m_Levels[0].width;
+    header.height = (uint32_t) m_Levels[0].height;
+    header.levelCount = (uint32_t) m_Levels.size();
+
+    std::vector<TextureFileLevel> table;
+    uint64_t offset = sizeof(header) + m_Levels.size() * sizeof(TextureFileLevel);
+    for (const TextureLevel& level : m_Levels)
+    {
+        offset = (offset + levelAlignment - 1) / levelAlignment * levelAlignment;
+        table.push_back({ (uint32_t) level.width, (uint32_t) level.height, offset, (uint64_t) level.size });
+        offset += level.size;
+    }
+
+    std::ofstream file(filepath, std::ios::binary);
+    if (!file)
+    {
+        std::cout << "Failed to open " << filepath << " for writing" << std::endl;
+        return false;
+    }
+    file.write((const char*) &header, sizeof(header));
+    file.write((const char*) table.data(), table.size() * sizeof(TextureFileLevel));
+    uint64_t written = sizeof(header) + table.size() * sizeof(TextureFileLevel);
+    static const char padding[levelAlignment] = {};
+    for (size_t i = 0; i < m_Levels.size(); i++)
+    {
+        file.write(padding, table[i].offset - written);
+        file.write((const char*) m_Levels[i].data, m_Levels[i].size);
+        written = table[i].offset + m_Levels[i].size;
+    }
+    return (bool) file;
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <MappedFile.h>
+
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
+// One mip level, data points into TextureData's pixels or its mapped file
+struct TextureLevel
+{
+    int width;
+    int height;
+    const unsigned char* data;
+    size_t size;
+};
+
+// Texture pixels on the CPU side, needs no GL context so it can be loaded on any thread.
+// Images are either decoded with stb_image (one RGBA8 level) or mapped from a baked .tex
+// container that already holds every mip level, possibly in a compressed GL format.
+class TextureData
+{
+    private:
+        std::string m_Filepath;
+        unsigned int m_Format;    // GL internal format of the levels
+        bool m_Compressed;
+        std::vector<TextureLevel> m_Levels;
+        std::vector<unsigned char> m_Pixels;
+        std::unique_ptr<MappedFile> m_File;
+
+        bool Decode(const std::string& filepath);
+        bool Map(const std::string& filepath);
+
+    public:
+        TextureData();
+
+        // Loads a .tex container or an image, an image with a .tex next to it loads the .tex
+        bool Load(const std::string& filepath);
+        // Starts Load on a worker thread, the texture is created from the result once GL is up
+        static std::future<TextureData> LoadAsync(const std::string& filepath);
+
+        // Fills in the levels down to 1x1 with a box filter, RGBA8 only
+        void GenerateMipmaps();
+        // Writes every level into a .tex container
+        bool Bake(const std::string& filepath) const;
+
+        inline bool IsValid() const { return !m_Levels.empty(); }
+        inline const std::string& GetFilepath() const { return m_Filepath; }
+        inline unsigned int GetFormat() const { return m_Format; }
+        inline bool IsCompressed() const { return m_Compressed; }
+        inline const std::vector<TextureLevel>& GetLevels() const { return m_Levels; }
+};
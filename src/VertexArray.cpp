@@ -2,6 +2,7 @@
 #include <VertexBufferLayout.h>
 
 VertexArray::VertexArray()
+    : m_AttribCount(0)
 {
     GLCall(glGenVertexArrays(1, &m_RendererID));
     if (m_RendererID == 0) {
@@ -14,18 +15,39 @@ VertexArray::~VertexArray()
     GLCall(glDeleteVertexArrays(1, &m_RendererID));
 }
         
-void VertexArray::AddBuffer(const VertexBuffer& vb, const VertexBufferLayout& layout)
+unsigned int VertexArray::AddBuffer(const VertexBuffer& vb, const VertexBufferLayout& layout, unsigned int divisor)
+{
+    unsigned int firstAttrib = m_AttribCount;
+    Bind();
+    const auto& elements = layout.GetElements();
+    for (unsigned int i = 0; i < elements.size(); i ++)
+    {
+        GLCall(glEnableVertexAttribArray(firstAttrib + i));
+    }
+    m_AttribCount += elements.size();
+    PointBuffer(firstAttrib, vb, layout, divisor, 0);
+    return firstAttrib;
+}
+
+void VertexArray::PointBuffer(unsigned int firstAttrib, const VertexBuffer& vb, const VertexBufferLayout& layout, unsigned int divisor, unsigned int baseOffset)
 {
     Bind();
     vb.Bind();
     const auto& elements = layout.GetElements();
-    unsigned int offset = 0;
+    unsigned int offset = baseOffset;
     for (unsigned int i = 0; i < elements.size(); i ++)
     {
         const auto& element = elements[i];
-        GLCall(glEnableVertexAttribArray(i));
-        GLCall(glVertexAttribPointer(i, element.count, element.type, element.normalized, layout.GetStride(), (const void*) (uintptr_t) offset));
-        offset += element.count * VertexBufferElement::GetSizeOfType(element.type);
+        if (element.integer)
+        {
+            GLCall(glVertexAttribIPointer(firstAttrib + i, element.count, element.type, layout.GetStride(), (const void*) (uintptr_t) offset));
+        }
+        else
+        {
+            GLCall(glVertexAttribPointer(firstAttrib + i, element.count, element.type, element.normalized, layout.GetStride(), (const void*) (uintptr_t) offset));
+        }
+        GLCall(glVertexAttribDivisor(firstAttrib + i, divisor));
+        offset += element.GetSize();
     }
 }
 
@@ -37,4 +59,4 @@ void VertexArray::Bind() const
 void VertexArray::Unbind() const
 {
     GLCall(glBindVertexArray(0));
-}
\ No newline at end of file
+}
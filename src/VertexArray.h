@@ -9,12 +9,17 @@ class VertexArray
 {
     private:
         unsigned int m_RendererID;
+        unsigned int m_AttribCount;
     public:
         VertexArray();
         ~VertexArray();
         
-        void AddBuffer(const VertexBuffer& vb, const VertexBufferLayout& layout);
+        // Appends the layout's attributes after the ones already added and returns the first
+        // attribute index. A divisor of 1 advances the attributes once per instance.
+        unsigned int AddBuffer(const VertexBuffer& vb, const VertexBufferLayout& layout, unsigned int divisor = 0);
+        // Points attributes added by AddBuffer at a different offset of the buffer
+        void PointBuffer(unsigned int firstAttrib, const VertexBuffer& vb, const VertexBufferLayout& layout, unsigned int divisor, unsigned int baseOffset);
 
         void Bind() const;
         void Unbind() const;
-};
\ No newline at end of file
+};
@@ -1,17 +1,58 @@
 #include <VertexBuffer.h>
 
 VertexBuffer::VertexBuffer(const void* data, unsigned int size)
+    : m_Size(size), m_Used(size)
 {
     GLCall(glGenBuffers(1, &m_RendererID));
     GLCall(glBindBuffer(GL_ARRAY_BUFFER, m_RendererID));
     GLCall(glBufferData(GL_ARRAY_BUFFER, size, data, GL_STATIC_DRAW));
 }
 
+VertexBuffer::VertexBuffer(unsigned int size)
+    : m_Size(size), m_Used(0)
+{
+    GLCall(glGenBuffers(1, &m_RendererID));
+    GLCall(glBindBuffer(GL_ARRAY_BUFFER, m_RendererID));
+    GLCall(glBufferData(GL_ARRAY_BUFFER, size, nullptr, GL_DYNAMIC_DRAW));
+}
+
 VertexBuffer::~VertexBuffer()
 {
     GLCall(glDeleteBuffers(1, &m_RendererID));
 }
 
+unsigned int VertexBuffer::Allocate(unsigned int size)
+{
+    ASSERT(m_Used + size <= m_Size);
+    unsigned int offset = m_Used;
+    m_Used += size;
+    return offset;
+}
+
+void VertexBuffer::SubData(unsigned int offset, const void* data, unsigned int size)
+{
+    ASSERT(offset + size <= m_Size);
+    GLCall(glBindBuffer(GL_ARRAY_BUFFER, m_RendererID));
+    GLCall(glBufferSubData(GL_ARRAY_BUFFER, offset, size, data));
+}
+
+void VertexBuffer::SetData(const void* data, unsigned int size)
+{
+    GLCall(glBindBuffer(GL_ARRAY_BUFFER, m_RendererID));
+    if (size > m_Size)
+    {
+        m_Size = size;
+        GLCall(glBufferData(GL_ARRAY_BUFFER, size, data, GL_DYNAMIC_DRAW));
+    }
+    else
+    {
+        // Orphan the old store so the driver does not wait for draws still using it
+        GLCall(glBufferData(GL_ARRAY_BUFFER, m_Size, nullptr, GL_DYNAMIC_DRAW));
+        GLCall(glBufferSubData(GL_ARRAY_BUFFER, 0, size, data));
+    }
+    m_Used = size;
+}
+
 void VertexBuffer::Bind() const
 {
     GLCall(glBindBuffer(GL_ARRAY_BUFFER, m_RendererID));
@@ -20,4 +61,4 @@ void VertexBuffer::Bind() const
 void VertexBuffer::Unbind() const
 {
     GLCall(glBindBuffer(GL_ARRAY_BUFFER, 0));
-}
\ No newline at end of file
+}
@@ -7,10 +7,23 @@ class VertexBuffer
 {
     private:
         unsigned int m_RendererID;
+        unsigned int m_Size;
+        unsigned int m_Used;
     public:
         VertexBuffer(const void* data, unsigned int size);
+        // Empty buffer of the given capacity that is filled through Allocate/SubData
+        VertexBuffer(unsigned int size);
         ~VertexBuffer();
 
+        // Reserves size bytes at the end of the used part and returns their offset
+        unsigned int Allocate(unsigned int size);
+        void SubData(unsigned int offset, const void* data, unsigned int size);
+        // Replaces the whole store, growing it when needed
+        void SetData(const void* data, unsigned int size);
+
         void Bind() const;
         void Unbind() const;
-};
\ No newline at end of file
+
+        inline unsigned int GetSize() const { return m_Size; }
+        inline unsigned int GetRendererID() const { return m_RendererID; }
+};
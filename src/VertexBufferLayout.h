@@ -4,13 +4,19 @@
 
 #include <Debugger.h>
 
+#include <cstdint>
 #include <vector>
 
+// Compact attribute types for Push, filled with glm/gtc/packing.hpp (packHalf1x16, packSnorm3x10_1x2)
+struct HalfFloat { uint16_t bits; };  // Read as float
+struct PackedSnorm { uint32_t bits; }; // x, y, z in 10 bits and w in 2, read as a normalized vec4
+
 struct VertexBufferElement
 {
     unsigned int type;
     unsigned int count;
     unsigned char normalized;
+    bool integer; // Read as int/uint in the shader instead of being converted to float
 
     static unsigned int GetSizeOfType(unsigned int type)
     {
@@ -22,10 +28,26 @@ struct VertexBufferElement
             return 4;
         case GL_UNSIGNED_BYTE:
             return 1;
+        case GL_HALF_FLOAT:
+        case GL_SHORT:
+        case GL_UNSIGNED_SHORT:
+            return 2;
+        case GL_INT_2_10_10_10_REV:
+            return 4;
         }
         ASSERT(false);
         return 0;
     }
+
+    // Packed types hold all components in one value
+    unsigned int GetSize() const
+    {
+        if (type == GL_INT_2_10_10_10_REV)
+        {
+            return GetSizeOfType(type);
+        }
+        return count * GetSizeOfType(type);
+    }
 };
 
 class VertexBufferLayout
@@ -44,6 +66,13 @@ class VertexBufferLayout
             static_assert(sizeof(T) == 0, "Unsupported type!");
         }
 
+        // Integer attributes (uint, uvec2, ...) that reach the shader unconverted
+        template<typename T>
+        void PushInteger(unsigned int count)
+        {
+            static_assert(sizeof(T) == 0, "Unsupported type!");
+        }
+
         inline const std::vector<VertexBufferElement> GetElements() const { return m_Elements; }
         inline unsigned int GetStride() const { return m_Stride; }
 };
@@ -51,20 +80,66 @@ class VertexBufferLayout
 template<>
 inline void VertexBufferLayout::Push<float>(unsigned int count)
 {
-    m_Elements.push_back({ GL_FLOAT, count, GL_FALSE });
+    m_Elements.push_back({ GL_FLOAT, count, GL_FALSE, false });
     m_Stride += count * VertexBufferElement::GetSizeOfType(GL_FLOAT);
 }
 
 template<>
 inline void VertexBufferLayout::Push<unsigned int>(unsigned int count)
 {
-    m_Elements.push_back({ GL_UNSIGNED_INT, count, GL_FALSE });
+    m_Elements.push_back({ GL_UNSIGNED_INT, count, GL_FALSE, false });
     m_Stride += count * VertexBufferElement::GetSizeOfType(GL_UNSIGNED_INT);
 }
 
 template<>
 inline void VertexBufferLayout::Push<unsigned char>(unsigned int count)
 {
-    m_Elements.push_back({ GL_UNSIGNED_BYTE, count, GL_TRUE });
+    m_Elements.push_back({ GL_UNSIGNED_BYTE, count, GL_TRUE, false });
     m_Stride += count * VertexBufferElement::GetSizeOfType(GL_UNSIGNED_BYTE);
-}
\ No newline at end of file
+}
+
+template<>
+inline void VertexBufferLayout::Push<HalfFloat>(unsigned int count)
+{
+    m_Elements.push_back({ GL_HALF_FLOAT, count, GL_FALSE, false });
+    m_Stride += count * VertexBufferElement::GetSizeOfType(GL_HALF_FLOAT);
+}
+
+// Normalized to [-1, 1]
+template<>
+inline void VertexBufferLayout::Push<short>(unsigned int count)
+{
+    m_Elements.push_back({ GL_SHORT, count, GL_TRUE, false });
+    m_Stride += count * VertexBufferElement::GetSizeOfType(GL_SHORT);
+}
+
+// Normalized to [0, 1]
+template<>
+inline void VertexBufferLayout::Push<unsigned short>(unsigned int count)
+{
+    m_Elements.push_back({ GL_UNSIGNED_SHORT, count, GL_TRUE, false });
+    m_Stride += count * VertexBufferElement::GetSizeOfType(GL_UNSIGNED_SHORT);
+}
+
+// Always four components, for normals and tangents
+template<>
+inline void VertexBufferLayout::Push<PackedSnorm>(unsigned int count)
+{
+    ASSERT(count == 4);
+    m_Elements.push_back({ GL_INT_2_10_10_10_REV, 4, GL_TRUE, false });
+    m_Stride += VertexBufferElement::GetSizeOfType(GL_INT_2_10_10_10_REV);
+}
+
+template<>
+inline void VertexBufferLayout::PushInteger<unsigned int>(unsigned int count)
+{
+    m_Elements.push_back({ GL_UNSIGNED_INT, count, GL_FALSE, true });
+    m_Stride += count * VertexBufferElement::GetSizeOfType(GL_UNSIGNED_INT);
+}
+
+template<>
+inline void VertexBufferLayout::PushInteger<unsigned char>(unsigned int count)
+{
+    m_Elements.push_back({ GL_UNSIGNED_BYTE, count, GL_FALSE, true });
+    m_Stride += count * VertexBufferElement::GetSizeOfType(GL_UNSIGNED_BYTE);
+}
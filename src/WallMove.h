@@ -0,0 +1,13 @@
+#pragma once
+
+// Default speed of an animated wall turn, the former 1 degree per frame at 60 Hz
+const float wallDegreesPerSecond = 60.0f;
+
+// A turn of one layer, in multiples of 45 degrees
+struct WallMove
+{
+    int axis;       // 0 = x, 1 = y, 2 = z
+    int layer;      // Absolute layer index along the axis
+    float degrees;  // Positive follows the right hand rule around the axis
+    float duration; // Animation length in seconds
+};
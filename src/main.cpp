@@ -2,6 +2,7 @@
 #include <GLFW/glfw3.h>
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/packing.hpp>
 
 #include <Debugger.h>
 #include <VertexBuffer.h>
@@ -10,13 +11,29 @@
 #include <VertexArray.h>
 #include <Shader.h>
 #include <Texture.h>
+#include <TextureData.h>
 #include <Camera.h>
-#include <Cube.h>
 #include <vector>
 #include <RubiksCube.h>
+#include <Animator.h>
+#include <Playback.h>
+#include <RenderThread.h>
+#include <StickerRenderer.h>
+#include <MeshBatch.h>
+#include <GLExtensions.h>
+#include <HeadlessContext.h>
+#include <ShaderCache.h>
+#include <FrameProfiler.h>
+#include <Framebuffer.h>
+#include <IdPicker.h>
+#include <ResolutionScaler.h>
 
 
+#include <chrono>
+#include <cstdio>
+#include <future>
 #include <iostream>
+#include <memory>
 
 
 float cubeVertices[] = {
@@ -58,7 +75,8 @@ float cubeVertices[] = {
     -0.5f, -0.5f,  0.5f,   0.0f, 1.0f, 1.0f,    0.0f, 1.0f   // Top-left
 };
 
-unsigned int cubeIndices[] = {
+// 16 bit indices, the shared cube mesh has 24 vertices
+unsigned short cubeIndices[] = {
     0, 1, 2,  2, 3, 0,  // Front face
     4, 5, 6,  6, 7, 4,  // Back face
     8, 9, 10, 10, 11, 8, // Left face
@@ -67,6 +85,27 @@ unsigned int cubeIndices[] = {
     20, 21, 22, 22, 23, 20  // Bottom face
 };
 
+// Compact vertex of the shared cube mesh, 16 bytes instead of the 32 of cubeVertices
+struct CubeVertex
+{
+    HalfFloat position[4];
+    unsigned char color[4];  // Normalized
+    HalfFloat texCoord[2];
+};
+
+// Vertex of the batched cubie mesh, the color comes from the instance by face
+struct CubieVertex
+{
+    HalfFloat position[4];
+    HalfFloat texCoord[2];
+    unsigned char face[4];   // Only the first byte is used, the rest keeps the stride aligned
+};
+
+static HalfFloat Half(float value)
+{
+    return { glm::packHalf1x16(value) };
+}
+
 
 /* Window size */
 const unsigned int width = 800;
@@ -74,46 +113,216 @@ const unsigned int height = 800;
 // const float FOVdegree = 45.0f;  // Field Of View Angle
 const float near = 0.1f;
 const float far = 100.0f;
+// From this size on the cube is drawn from its sticker textures instead of cubies
+const int stickerModeSize = 8;
+
+/* Draws the cube into an offscreen framebuffer and saves it as a PNG. With more than one
+   frame the drawing is repeated and timed, for benchmarks on machines without a display. */
+static bool RenderHeadless(Rubikscube& rubik, const glm::mat4& mvp, int cubeSize, int renderWidth, int renderHeight, int frames, const std::string& output, FrameProfiler* profiler)
+{
+    Framebuffer framebuffer(renderWidth, renderHeight);
+    if (!framebuffer.IsComplete())
+    {
+        return false;
+    }
+    framebuffer.Bind();
+
+    SceneSnapshot scene(cubeSize);
+    auto start = std::chrono::steady_clock::now();
+    for (int frame = 0; frame < frames; frame++)
+    {
+        ProfileScope scope(profiler, "submit");
+        rubik.Snapshot(scene, mvp);
+        if (profiler)
+        {
+            profiler->BeginGpu("gpu draw");
+        }
+        rubik.Draw(scene);
+        if (profiler)
+        {
+            profiler->EndGpu();
+            profiler->EndFrame();
+        }
+        GLCheckFrame("headless frame");
+    }
+    GLCall(glFinish());
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    if (frames > 1)
+    {
+        std::cout << frames << " frames in " << elapsed.count() << " ms, " << elapsed.count() / frames << " ms per frame" << std::endl;
+    }
+    if (profiler)
+    {
+        profiler->Report(std::cout);
+    }
 
+    if (!framebuffer.SavePNG(output))
+    {
+        return false;
+    }
+    std::cout << "Wrote " << output << " (" << renderWidth << "x" << renderHeight << ")" << std::endl;
+    return true;
+}
 
 int main(int argc, char* argv[])
 {
     int cubeSize = 3;
-    if(argc >= 2){
-        cubeSize = std::stoi(argv[1]);
+    int stickerMode = -1; // -1 = pick by size, 0 = cubies, 1 = stickers
+    bool continuous = false; // Redraw every frame instead of only on changes
+    bool renderThread = true; // Draw on a thread of its own, see RenderThread
+    std::string playFile; // Move sequence to replay, see Playback
+    double playRate = 0.0;
+    std::string headlessOutput; // Render one image to this PNG without a window
+    int renderWidth = width, renderHeight = height;
+    std::string moves;    // Applied before the first frame, in Playback notation
+    glm::vec3 cameraPosition(0.0f, 0.0f, 10.0f);
+    glm::vec2 cubeRotation(0.0f);
+    float fov = 45.0f;
+    int benchmarkFrames = 1;
+    std::string recordOutput; // PNG pattern or .y4m file, see FrameEncoder
+    int recordRate = 60;
+    bool glDebug = false; // Debug context with driver messages, see GLEnableDebugOutput
+    bool profile = false; // Time frame phases and report them, see FrameProfiler
+    bool flat = false; // Plain colored cubies without the sticker texture
+    bool vertexPulling = false; // Cubies without vertex data, see ProceduralCubeRenderer
+    bool gpuPicking = false; // Pick stickers from an ID buffer instead of ray casting, see IdPicker
+    bool dynamicResolution = false; // Lower the render scale while over the frame budget, see ResolutionScaler
+    float frameBudget = 0.0f; // GPU milliseconds per frame, 0 for the display's refresh interval
+    std::string shaderCache = "cache/shaders"; // Linked program binaries, see ShaderCache
+    std::string bakeInput, bakeOutput; // Write an image with all its mip levels to a .tex file
+    for(int i = 1; i < argc; i++){
+        std::string arg = argv[i];
+        if(arg == "--stickers"){
+            stickerMode = 1;
+        } else if(arg == "--cubies"){
+            stickerMode = 0;
+        } else if(arg == "--continuous"){
+            continuous = true;
+        } else if(arg == "--single-thread"){
+            renderThread = false;
+        } else if(arg == "--play" && i + 1 < argc){
+            playFile = argv[++i];
+        } else if(arg == "--play-rate" && i + 1 < argc){
+            playRate = std::stod(argv[++i]);
+        } else if(arg == "--headless" && i + 1 < argc){
+            headlessOutput = argv[++i];
+        } else if(arg == "--resolution" && i + 1 < argc){
+            std::sscanf(argv[++i], "%dx%d", &renderWidth, &renderHeight);
+        } else if(arg == "--moves" && i + 1 < argc){
+            moves = argv[++i];
+        } else if(arg == "--camera" && i + 1 < argc){
+            std::sscanf(argv[++i], "%f,%f,%f", &cameraPosition.x, &cameraPosition.y, &cameraPosition.z);
+        } else if(arg == "--rotate" && i + 1 < argc){
+            std::sscanf(argv[++i], "%f,%f", &cubeRotation.x, &cubeRotation.y);
+        } else if(arg == "--fov" && i + 1 < argc){
+            fov = std::stof(argv[++i]);
+        } else if(arg == "--record" && i + 1 < argc){
+            recordOutput = argv[++i];
+            continuous = true; // Every displayed frame becomes a video frame
+        } else if(arg == "--record-fps" && i + 1 < argc){
+            recordRate = std::stoi(argv[++i]);
+        } else if(arg == "--gl-debug"){
+            glDebug = true;
+        } else if(arg == "--profile"){
+            profile = true;
+        } else if(arg == "--flat"){
+            flat = true;
+        } else if(arg == "--vertex-pulling"){
+            vertexPulling = true;
+        } else if(arg == "--gpu-picking"){
+            gpuPicking = true;
+        } else if(arg == "--dynamic-resolution"){
+            dynamicResolution = true;
+        } else if(arg == "--frame-budget" && i + 1 < argc){
+            frameBudget = std::stof(argv[++i]);
+            dynamicResolution = true;
+        } else if(arg == "--shader-cache" && i + 1 < argc){
+            shaderCache = argv[++i];
+        } else if(arg == "--no-shader-cache"){
+            shaderCache.clear();
+        } else if(arg == "--bake-texture" && i + 2 < argc){
+            bakeInput = argv[++i];
+            bakeOutput = argv[++i];
+        } else if(arg == "--frames" && i + 1 < argc){
+            benchmarkFrames = std::max(1, std::stoi(argv[++i]));
+        } else{
+            cubeSize = std::stoi(arg);
+        }
     }
-    GLFWwindow* window;
-
-    /* Initialize the library */
-    if (!glfwInit())
-    {
+    if(stickerMode == -1){
+        stickerMode = cubeSize >= stickerModeSize ? 1 : 0;
+    }
+    std::vector<WallMove> startMoves;
+    if(!Playback::ParseMoves(moves, cubeSize, startMoves)){
         return -1;
     }
-    
-    /* Set OpenGL to Version 3.3.0 */
-    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
-    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
-    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
-
-    /* Create a windowed mode window and its OpenGL context */
-    window = glfwCreateWindow(width, height, "OpenGL", NULL, NULL);
-    if (!window)
+    if(!bakeInput.empty()){
+        TextureData image;
+        if(!image.Load(bakeInput)){
+            return -1;
+        }
+        image.GenerateMipmaps();
+        return image.Bake(bakeOutput) ? 0 : -1;
+    }
+
+    ShaderCache::SetDirectory(shaderCache);
+
+    /* Decode the texture while the window and context are being created */
+    std::future<TextureData> textureData = TextureData::LoadAsync("res/textures/plane.png");
+
+    const bool headless = !headlessOutput.empty();
+    GLFWwindow* window = nullptr;
+    HeadlessContext headlessContext;
+
+    if (headless)
     {
-        glfwTerminate();
-        return -1;
+        /* Offscreen context, works without a display or GPU */
+        if (!headlessContext.Create(glDebug))
+        {
+            return -1;
+        }
+        gladLoadGLLoader(HeadlessContext::GetProcAddress);
+        GLExtensions::Load(HeadlessContext::GetProcAddress);
     }
+    else
+    {
+        /* Initialize the library */
+        if (!glfwInit())
+        {
+            return -1;
+        }
+    
+        /* Set OpenGL to Version 3.3.0 */
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+        glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+        glfwWindowHint(GLFW_OPENGL_DEBUG_CONTEXT, glDebug ? GLFW_TRUE : GLFW_FALSE);
 
-    /* Make the window's context current */
-    glfwMakeContextCurrent(window);
+        /* Create a windowed mode window and its OpenGL context */
+        window = glfwCreateWindow(width, height, "OpenGL", NULL, NULL);
+        if (!window)
+        {
+            glfwTerminate();
+            return -1;
+        }
 
-    /* Load GLAD so it configures OpenGL */
-    gladLoadGL();
+        /* Make the window's context current */
+        glfwMakeContextCurrent(window);
 
-    /* Control frame rate */
-    glfwSwapInterval(1);
+        /* Load GLAD so it configures OpenGL */
+        gladLoadGL();
+        GLExtensions::Load((GLADloadproc) glfwGetProcAddress);
+
+        /* Control frame rate */
+        glfwSwapInterval(1);
+    }
 
     /* Print OpenGL version after completing initialization */
     std::cout << "OpenGL Version: " << glGetString(GL_VERSION) << std::endl;
+    if (glDebug && !GLEnableDebugOutput())
+    {
+        std::cout << "GL debug output needs GL 4.3 or KHR_debug" << std::endl;
+    }
 
     /* Set scope so that on widow close the destructors will be called automatically */
     {
@@ -123,21 +332,88 @@ int main(int argc, char* argv[])
 
         /* Create cube */
         //Cube cube = Cube();
-        Texture texture("res/textures/plane.png");
-        Shader shader("res/shaders/basic.shader");
+        /* All shader variants are compiled together, link errors show on first use */
+        std::vector<std::string> textured;
+        if (!flat)
+        {
+            textured.push_back("TEXTURED");
+        }
+        Shader cubiesShader("res/shaders/cube.shader", textured);
+        Shader stickerShader("res/shaders/stickers.shader");
+        std::unique_ptr<Shader> pulledShader;
+        if (vertexPulling)
+        {
+            std::vector<std::string> pulled = textured;
+            pulled.push_back("PULLED");
+            pulledShader.reset(new Shader("res/shaders/cube.shader", pulled));
+        }
+        std::unique_ptr<Shader> pickShader;
+        if (gpuPicking && stickerMode == 0 && !headless)
+        {
+            pickShader.reset(new Shader("res/shaders/cube.shader", { "PULLED", "PICKING" }));
+        }
+        else if (gpuPicking)
+        {
+            std::cout << "GPU picking needs the cubie mode of a window, picking on the CPU" << std::endl;
+        }
+
+        Texture texture(textureData.get());
+        Texture* cubieTexture = flat ? nullptr : &texture;
             // Configure the shared VertexArray
         VertexArray va;
-        VertexBuffer vb(cubeVertices, sizeof(cubeVertices));
+        // Positions and texture coordinates are exact as half floats (0, +-0.5 and 1)
+        const int cubeVertexCount = sizeof(cubeVertices) / (8 * sizeof(float));
+        CubeVertex compactVertices[cubeVertexCount];
+        CubieVertex cubieVertices[cubeVertexCount];
+        for (int i = 0; i < cubeVertexCount; i++) {
+            const float* vertex = &cubeVertices[i * 8];
+            compactVertices[i] = {
+                { Half(vertex[0]), Half(vertex[1]), Half(vertex[2]), Half(1.0f) },
+                { (unsigned char) (vertex[3] * 255.0f), (unsigned char) (vertex[4] * 255.0f), (unsigned char) (vertex[5] * 255.0f), 255 },
+                { Half(vertex[6]), Half(vertex[7]) }
+            };
+            cubieVertices[i] = {
+                { Half(vertex[0]), Half(vertex[1]), Half(vertex[2]), Half(1.0f) },
+                { Half(vertex[6]), Half(vertex[7]) },
+                { (unsigned char) (i / 4), 0, 0, 0 }
+            };
+        }
+        VertexBuffer vb(compactVertices, sizeof(compactVertices));
         VertexBufferLayout layout;
-        layout.Push<float>(3);  // Positions
-        layout.Push<float>(3);  // Colors
-        layout.Push<float>(2);  // Texture coordinates
+        layout.Push<HalfFloat>(4);  // Positions
+        layout.Push<unsigned char>(4);  // Colors
+        layout.Push<HalfFloat>(2);  // Texture coordinates
         va.AddBuffer(vb, layout);  // Configure the VAO
 
         // Setup shared IndexBuffer
         IndexBuffer ib(cubeIndices, sizeof(cubeIndices));
         ib.Bind();  // Bind the IndexBuffer to the VAO
-        Rubikscube rubik = Rubikscube(cubeSize, &shader, &texture, &va);
+        StickerRenderer stickerRenderer(&stickerShader, &va, &ib);
+        Rubikscube rubik = Rubikscube(cubeSize, stickerMode ? &stickerRenderer : nullptr);
+
+        // One static cubie mesh without colors, four vertices per face in sticker face order
+        VertexBufferLayout cubieLayout;
+        cubieLayout.Push<HalfFloat>(4);  // Positions
+        cubieLayout.Push<HalfFloat>(2);  // Texture coordinates
+        cubieLayout.PushInteger<unsigned char>(4);  // Face
+
+        // Shared buffers for every mesh of the scene, per instance a model matrix and the face colors (CubieInstance)
+        VertexBufferLayout instanceLayout;
+        for (int column = 0; column < 4; column++) {
+            instanceLayout.Push<float>(4);
+        }
+        instanceLayout.PushInteger<unsigned int>(2);
+        const unsigned int cubeIndexCount = sizeof(cubeIndices) / sizeof(unsigned short);
+        MeshBatch batch(cubieLayout, instanceLayout, sizeof(cubieVertices), cubeIndexCount, GL_UNSIGNED_SHORT);
+        MeshHandle cubeMesh = batch.AddMesh(cubieVertices, sizeof(cubieVertices), cubeIndices, cubeIndexCount);
+        rubik.SetBatch(&batch, cubeMesh, &cubiesShader, cubieTexture);
+        std::unique_ptr<ProceduralCubeRenderer> proceduralRenderer;
+        if (pulledShader)
+        {
+            proceduralRenderer.reset(new ProceduralCubeRenderer(pulledShader.get(), cubieTexture));
+            rubik.SetProceduralRenderer(proceduralRenderer.get());
+        }
+        std::cout << "Cubie submission: " << (proceduralRenderer ? "vertex pulling" : batch.UsesMultiDrawIndirect() ? "glMultiDrawElementsIndirect" : "glDrawElementsInstanced") << " from a persistent instance buffer" << std::endl;
     
         /* Enables the Depth Buffer */
     	GLCall(glEnable(GL_DEPTH_TEST));
@@ -145,27 +421,171 @@ int main(int argc, char* argv[])
         /* Create camera */
         Camera camera(width, height);
         //Added
-        const float FOVdegree = 45.0f;
-        const float aspectRatio = static_cast<float>(width) / height;
+        const float FOVdegree = fov;
+        const float aspectRatio = headless ? static_cast<float>(renderWidth) / renderHeight : static_cast<float>(width) / height;
         camera.SetPerspective(FOVdegree, aspectRatio, near, far);
-        camera.SetPosition(glm::vec3(0.0f, 0.0f, 10.0f)); // Move the camera 10 units back
+        camera.SetPosition(cameraPosition); // 10 units back unless given
         //End
         camera.SetRubiksCube(&rubik);
+
+        /* Starting state from the command line */
+        for (const WallMove& move : startMoves)
+        {
+            rubik.ApplyWallMove(move);
+        }
+        if (cubeRotation != glm::vec2(0.0f))
+        {
+            rubik.Rotate(cubeRotation.x, cubeRotation.y);
+        }
+
+        std::unique_ptr<FrameProfiler> profiler;
+        if (profile)
+        {
+            profiler.reset(new FrameProfiler());
+        }
+
+        if (headless)
+        {
+            glm::mat4 mvp = camera.GetProjectionMatrix() * camera.GetViewMatrix();
+            return RenderHeadless(rubik, mvp, cubeSize, renderWidth, renderHeight, benchmarkFrames, headlessOutput, profiler.get()) ? 0 : -1;
+        }
+
+        Animator animator(&rubik);
+        camera.SetAnimator(&animator);
+        Playback playback(&rubik, &animator);
+        camera.SetPlayback(&playback);
+        if (playRate > 0.0)
+        {
+            playback.SetRate(playRate);
+        }
+        if (!playFile.empty() && playback.LoadFile(playFile))
+        {
+            playback.Play();
+        }
         camera.EnableInputs(window);
 
+        /* While animating, wake up about once per displayed frame to publish a new snapshot */
+        const GLFWvidmode* videoMode = glfwGetVideoMode(glfwGetPrimaryMonitor());
+        const double frameInterval = 1.0 / (videoMode && videoMode->refreshRate > 0 ? videoMode->refreshRate : 60);
+        SceneBuffer scenes(cubeSize);
+        int framebufferWidth, framebufferHeight;
+        glfwGetFramebufferSize(window, &framebufferWidth, &framebufferHeight);
+        std::unique_ptr<FrameRecorder> recorder;
+        if (!recordOutput.empty())
+        {
+            recorder.reset(new FrameRecorder(framebufferWidth, framebufferHeight, recordOutput, recordRate));
+            if (!recorder->IsOpen())
+            {
+                return -1;
+            }
+        }
+        std::unique_ptr<IdPicker> picker;
+        if (pickShader)
+        {
+            picker.reset(new IdPicker(framebufferWidth, framebufferHeight, cubeSize, &rubik.GetDrawnCubies(), pickShader.get()));
+            camera.idPicker = picker.get();
+        }
+        std::unique_ptr<ResolutionScaler> scaler;
+        if (dynamicResolution)
+        {
+            scaler.reset(new ResolutionScaler(framebufferWidth, framebufferHeight, frameBudget > 0.0f ? frameBudget : (float) (frameInterval * 1000.0)));
+        }
+        RenderThread renderer(window, &rubik, &scenes);
+        renderer.SetRecorder(recorder.get());
+        renderer.SetProfiler(profiler.get());
+        renderer.SetPicker(picker.get());
+        renderer.SetScaler(scaler.get());
+        const double reportInterval = 2.0;
+        double nextReport = glfwGetTime() + reportInterval;
+        if (renderThread)
+        {
+            renderer.Start();
+        }
+
         /* Loop until the user closes the window */
         while (!glfwWindowShouldClose(window))
         {
+            /* Advance playback and wall turns by the time that passed */
+            double now = glfwGetTime();
+            {
+                ProfileScope scope(profiler.get(), "update");
+                playback.Update(now);
+                animator.Update(now);
+            }
+
+            /* A pick is drawn with the next frame and read back a frame or two later */
+            bool picking = picker && picker->IsBusy();
+            if (continuous || rubik.IsDirty() || picking)
+            {
+                /* Initialize uniform color */
+                glm::mat4 view = camera.GetViewMatrix();
+                glm::mat4 proj = camera.GetProjectionMatrix();
+                glm::mat4 mvp = proj * view;
+
+                if (renderer.IsRunning())
+                {
+                    ProfileScope scope(profiler.get(), "snapshot");
+                    rubik.Snapshot(scenes.GetBack(), mvp);
+                    scenes.Publish();
+                }
+                else
+                {
+                    SceneSnapshot& scene = scenes.GetBack();
+                    rubik.Snapshot(scene, mvp);
+                    renderer.DrawFrame(scene);
+                }
+            }
 
-            /* Initialize uniform color */
-            glm::mat4 view = camera.GetViewMatrix();
-            glm::mat4 proj = camera.GetProjectionMatrix();
-            glm::mat4 mvp = proj * view;
+            bool pickHit;
+            PickResult pick;
+            if (picker && picker->Poll(pickHit, pick))
+            {
+                camera.HandleGpuPick(pickHit, pick);
+            }
 
-            rubik.Render(mvp, window);
+            if (profiler && now >= nextReport)
+            {
+                /* Whether the CPU or the GPU bounds the frame, in the title and on stdout */
+                FrameProfiler::Stats frame = profiler->GetStats("frame");
+                FrameProfiler::Stats submit = profiler->GetStats("submit");
+                FrameProfiler::Stats gpu = profiler->GetStats("gpu draw");
+                char title[256];
+                int length = std::snprintf(title, sizeof(title), "OpenGL - frame p95 %.2f ms, cpu submit p95 %.2f ms, gpu p95 %.2f ms", frame.p95, submit.p95, gpu.p95);
+                if (scaler && length > 0 && length < (int) sizeof(title))
+                {
+                    std::snprintf(title + length, sizeof(title) - length, ", scale %.0f%%", scaler->GetScale() * 100.0f);
+                }
+                glfwSetWindowTitle(window, title);
+                profiler->Report(std::cout);
+                nextReport = now + reportInterval;
+            }
 
-            /* Poll for and process events */
-            glfwPollEvents();
+            bool busy = continuous || rubik.IsDirty() || animator.IsBusy() || playback.IsPlaying() || picking;
+            if (!busy && scaler && scaler->NeedsSettle())
+            {
+                /* Motion stopped, show the still image at full resolution */
+                scaler->Settle();
+                rubik.MarkDirty();
+                busy = true;
+            }
+            if (busy)
+            {
+                /* Poll for and process events */
+                if (renderer.IsRunning())
+                {
+                    /* Swapping no longer paces this loop, events still wake it right away */
+                    glfwWaitEventsTimeout(frameInterval);
+                }
+                else
+                {
+                    glfwPollEvents();
+                }
+            }
+            else
+            {
+                /* Nothing to draw, sleep until an event arrives */
+                glfwWaitEvents();
+            }
         }
     }
 
@@ -0,0 +1,99 @@
+#shader vertex
+#version 330
+
+// One draw for all cubies, model matrix and face colors per instance (MeshBatch), turned
+// walls from uniforms (include/turns.glsl). Variants:
+// TEXTURED   sticker shapes from u_Texture instead of plain colors
+// PULLED     the same without vertex data, the cube is built from gl_VertexID and
+//            the cubies are read from u_Cubies (ProceduralCubeRenderer)
+// PICKING    with PULLED, writes cubie index * 8 + face + 1 to an integer target (IdPicker)
+
+#include "include/palette.glsl"
+#include "include/turns.glsl"
+
+#ifdef PULLED
+uniform usamplerBuffer u_Cubies; // CubieInstance as 9 RG32UI texels per cubie
+
+// Corners of the two triangles of a face, corner k has the texture coordinates of cubeVertices
+const int faceCorners[6] = int[6](0, 1, 2, 2, 3, 0);
+#else
+layout(location = 0) in vec3 position;
+layout(location = 1) in vec2 texCoord;
+layout(location = 2) in uint face;       // Sticker face order, see StickerState
+layout(location = 3) in mat4 model;      // Per cubie
+layout(location = 7) in uvec2 faceColors; // Per cubie, one palette index byte per face
+#endif
+
+out vec4 v_Color;
+out vec2 v_TexCoord;
+#ifdef PICKING
+flat out uint v_PickID;
+#endif
+
+uniform mat4 u_MVP;
+
+void main()
+{
+#ifdef PULLED
+	// Six vertices per face in sticker face order, the faces of cubeVertices
+	uint face = uint(gl_VertexID / 6);
+	int corner = faceCorners[gl_VertexID % 6];
+	vec2 texCoord = vec2(corner == 1 || corner == 2 ? 1.0 : 0.0, corner >= 2 ? 1.0 : 0.0);
+	vec2 uv = texCoord - 0.5;
+	float side = (face == 0u || face == 3u || face == 4u) ? 0.5 : -0.5;
+	vec3 position;
+	if (face < 2u) { position = vec3(uv.x, uv.y, side); }
+	else if (face < 4u) { position = vec3(side, uv.y, uv.x); }
+	else { position = vec3(uv.x, side, uv.y); }
+
+	int base = gl_InstanceID * 9;
+	mat4 model;
+	for (int column = 0; column < 4; column++)
+	{
+		uvec2 low = texelFetch(u_Cubies, base + 2 * column).rg;
+		uvec2 high = texelFetch(u_Cubies, base + 2 * column + 1).rg;
+		model[column] = uintBitsToFloat(uvec4(low, high));
+	}
+	uvec2 faceColors = texelFetch(u_Cubies, base + 8).rg;
+#endif
+	gl_Position = u_MVP * TurnLayer(model) * vec4(position, 1.0);
+	uint color = (faceColors[face / 4u] >> (8u * (face % 4u))) & 0xFFu;
+	v_Color = vec4(palette[min(color, paletteBody)], 1.0);
+	v_TexCoord = texCoord;
+#ifdef PICKING
+	v_PickID = uint(gl_InstanceID) * 8u + face + 1u;
+#endif
+}
+
+#shader fragment
+#version 330
+
+#ifdef PICKING
+layout(location = 0) out uint PickID;
+
+flat in uint v_PickID;
+
+void main()
+{
+	PickID = v_PickID;
+}
+#else
+layout(location = 0) out vec4 FragColor;
+
+in vec4 v_Color;
+in vec2 v_TexCoord;
+
+uniform vec4 u_Color;
+#ifdef TEXTURED
+uniform sampler2D u_Texture;
+#endif
+
+void main()
+{
+#ifdef TEXTURED
+	FragColor = texture(u_Texture, v_TexCoord) * u_Color * v_Color;
+#else
+	FragColor = u_Color * v_Color;
+#endif
+}
+#endif
@@ -0,0 +1,7 @@
+// Sticker colors by palette index, see StickerState, the last entry is the black cube body
+const uint paletteBody = 6u;
+const vec3 palette[7] = vec3[7](
+	vec3(1.0, 0.0, 0.0), vec3(0.0, 1.0, 0.0), vec3(0.0, 0.0, 1.0),
+	vec3(1.0, 1.0, 0.0), vec3(1.0, 0.0, 1.0), vec3(0.0, 1.0, 1.0),
+	vec3(0.0, 0.0, 0.0)
+);
@@ -0,0 +1,29 @@
+// Turned walls, see LayerTurns. The layer of a cubie along u_TurnAxis comes from the
+// translation of its rest matrix, cubies in a range are turned about the axis.
+const int maxTurns = 8;
+uniform int u_TurnAxis;
+uniform float u_GridOffset;
+uniform int u_TurnCount;
+uniform vec3 u_Turns[maxTurns]; // First layer, last layer, radians
+
+mat4 TurnLayer(mat4 model)
+{
+	float layer = model[3][u_TurnAxis] + u_GridOffset;
+	for (int i = 0; i < u_TurnCount; i++)
+	{
+		if (layer > u_Turns[i].x - 0.5 && layer < u_Turns[i].y + 0.5)
+		{
+			float c = cos(u_Turns[i].z);
+			float s = sin(u_Turns[i].z);
+			int a = (u_TurnAxis + 1) % 3;
+			int b = (u_TurnAxis + 2) % 3;
+			mat4 rotation = mat4(1.0);
+			rotation[a][a] = c;
+			rotation[a][b] = s;
+			rotation[b][a] = -s;
+			rotation[b][b] = c;
+			return rotation * model;
+		}
+	}
+	return model;
+}
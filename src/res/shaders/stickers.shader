@@ -0,0 +1,62 @@
+#shader vertex
+#version 330
+
+layout(location = 0) in vec3 position;
+
+flat out int v_Face;
+out vec3 v_Grid;
+
+uniform mat4 u_MVP;
+uniform vec3 u_BoxMin;
+uniform vec3 u_BoxMax;
+uniform float u_Size;
+
+void main()
+{
+	// The cube mesh stores four vertices per face, in sticker face order
+	v_Face = gl_VertexID / 4;
+	v_Grid = mix(u_BoxMin, u_BoxMax, position + 0.5);
+	gl_Position = u_MVP * vec4(v_Grid - 0.5 * u_Size, 1.0);
+}
+
+#shader fragment
+#version 330
+
+layout(location = 0) out vec4 FragColor;
+
+flat in int v_Face;
+in vec3 v_Grid;
+
+uniform usampler2DArray u_Stickers;
+uniform float u_Size;
+
+#include "include/palette.glsl"
+
+const vec3 body = palette[paletteBody];
+
+void main()
+{
+	// Sticker coordinates on the face and the coordinate along its normal
+	vec2 uv;
+	float depth;
+	if (v_Face < 2) { uv = v_Grid.xy; depth = v_Grid.z; }
+	else if (v_Face < 4) { uv = v_Grid.zy; depth = v_Grid.x; }
+	else { uv = v_Grid.xz; depth = v_Grid.y; }
+
+	// Faces of a box that lie inside the cube are cuts of a turning layer
+	bool positive = v_Face == 0 || v_Face == 3 || v_Face == 4;
+	if (abs(depth - (positive ? u_Size : 0.0)) > 0.001)
+	{
+		FragColor = vec4(body, 1.0);
+		return;
+	}
+
+	ivec2 cell = clamp(ivec2(floor(uv)), ivec2(0), ivec2(int(u_Size) - 1));
+	uint sticker = texelFetch(u_Stickers, ivec3(cell, v_Face), 0).r;
+
+	// Rounded sticker with a black border, like the cubie texture
+	vec2 d = abs(uv - vec2(cell) - 0.5);
+	float radius = 0.12;
+	float dist = length(max(d - (0.44 - radius), 0.0)) - radius;
+	FragColor = vec4(dist > 0.0 ? body : palette[min(sticker, 5u)], 1.0);
+}